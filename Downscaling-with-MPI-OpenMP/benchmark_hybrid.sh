@@ -0,0 +1,88 @@
+#!/bin/bash
+
+# Hybrid MPI+OpenMP rank x thread sweep on a large image.
+# Usage: ./benchmark_hybrid.sh [image] [size]
+# Without an image, a random size x size PGM (default 8192) is generated.
+#
+# Ranks are not bound to cores so each rank's thread team can spread over
+# its socket; set MPIRUN_FLAGS to change the placement (e.g.
+# "--map-by ppr:1:socket:pe=8" for one rank per socket on Open MPI).
+
+# Force English locale for numeric operations
+export LC_ALL=C
+export LC_NUMERIC=C
+
+SIZE=${2:-8192}
+if [ -n "$1" ]; then
+    IMAGE="$1"
+else
+    IMAGE="large_${SIZE}.pgm"
+    if [ ! -f "$IMAGE" ]; then
+        echo "Generating ${SIZE}x${SIZE} test image: $IMAGE"
+        { printf "P5\n%d %d\n255\n" "$SIZE" "$SIZE"; head -c $((SIZE * SIZE)) /dev/urandom; } > "$IMAGE"
+    fi
+fi
+
+RUNS=3
+RANKS_LIST=${RANKS_LIST:-"1 2 4"}
+THREADS_LIST=${THREADS_LIST:-"1 2 4 8"}
+MPIRUN_FLAGS=${MPIRUN_FLAGS:-"--bind-to none"}
+
+echo "=== Hybrid MPI+OpenMP Rank x Thread Benchmark ==="
+echo "Image: $IMAGE"
+echo "Ranks: $RANKS_LIST  Threads per rank: $THREADS_LIST"
+echo "Number of runs per test: $RUNS"
+echo ""
+
+# Function to calculate average
+calculate_average() {
+    local sum=0
+    local count=0
+    for val in "$@"; do
+        sum=$(echo "$sum + $val" | bc -l)
+        count=$((count + 1))
+    done
+    # Add leading zero if needed
+    local avg=$(echo "scale=6; $sum / $count" | bc -l)
+    if [[ $avg == .* ]]; then
+        avg="0$avg"
+    fi
+    echo "$avg"
+}
+
+echo "Ranks,Threads,Cores,Compute,Average,Speedup,Efficiency" > results_hybrid.csv
+
+BASE=""
+for NRANKS in $RANKS_LIST; do
+    for NTHREADS in $THREADS_LIST; do
+        CORES=$((NRANKS * NTHREADS))
+        echo "Running with $NRANKS rank(s) x $NTHREADS thread(s)..."
+        TIMES=()
+        COMPUTES=()
+        for i in $(seq 1 $RUNS); do
+            OUT=$(OMP_NUM_THREADS=$NTHREADS mpirun $MPIRUN_FLAGS -np $NRANKS \
+                  ./hybrid_main "$IMAGE" hybrid_bench.jpg $NTHREADS 2>/dev/null)
+            TIME=$(echo "$OUT" | grep "Elapsed time:" | awk '{print $3}')
+            COMPUTE=$(echo "$OUT" | grep "Downscale time" | awk '{print $5}')
+            TIMES+=($TIME)
+            COMPUTES+=($COMPUTE)
+        done
+        AVG=$(calculate_average "${TIMES[@]}")
+        COMP=$(calculate_average "${COMPUTES[@]}")
+        if [ -z "$BASE" ]; then
+            BASE=$AVG
+        fi
+        SPEEDUP=$(echo "scale=4; $BASE / $AVG" | bc -l)
+        EFFICIENCY=$(echo "scale=4; $SPEEDUP / $CORES" | bc -l)
+        echo "$NRANKS,$NTHREADS,$CORES,$COMP,$AVG,$SPEEDUP,$EFFICIENCY" >> results_hybrid.csv
+        echo "  Compute: $COMP s, Average: $AVG s, Speedup: $SPEEDUP"
+    done
+done
+
+rm -f hybrid_bench.jpg
+
+echo ""
+echo "=== Hybrid Benchmark Complete ==="
+echo "Results saved to results_hybrid.csv"
+echo ""
+cat results_hybrid.csv
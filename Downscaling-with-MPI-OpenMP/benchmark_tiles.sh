@@ -0,0 +1,73 @@
+#!/bin/bash
+
+# OpenMP band-tiled downscaling scaling benchmark on a large image.
+# Usage: ./benchmark_tiles.sh [image] [size]
+# Without an image, a random size x size PGM (default 8192) is generated.
+
+# Force English locale for numeric operations
+export LC_ALL=C
+export LC_NUMERIC=C
+
+SIZE=${2:-8192}
+if [ -n "$1" ]; then
+    IMAGE="$1"
+else
+    IMAGE="large_${SIZE}.pgm"
+    if [ ! -f "$IMAGE" ]; then
+        echo "Generating ${SIZE}x${SIZE} test image: $IMAGE"
+        { printf "P5\n%d %d\n255\n" "$SIZE" "$SIZE"; head -c $((SIZE * SIZE)) /dev/urandom; } > "$IMAGE"
+    fi
+fi
+
+RUNS=3
+
+echo "=== OpenMP Band-Tiled Scaling Benchmark ==="
+echo "Image: $IMAGE"
+echo "Number of runs per test: $RUNS"
+echo ""
+
+# Function to calculate average
+calculate_average() {
+    local sum=0
+    local count=0
+    for val in "$@"; do
+        sum=$(echo "$sum + $val" | bc -l)
+        count=$((count + 1))
+    done
+    # Add leading zero if needed
+    local avg=$(echo "scale=6; $sum / $count" | bc -l)
+    if [[ $avg == .* ]]; then
+        avg="0$avg"
+    fi
+    echo "$avg"
+}
+
+echo "Threads,BandRows,Average,Speedup,Efficiency" > results_tiles.csv
+
+BASE=""
+for NTHREADS in 1 2 4 8 16; do
+    echo "Running with $NTHREADS thread(s)..."
+    TIMES=()
+    for i in $(seq 1 $RUNS); do
+        OUT=$(./openmp_main "$IMAGE" tiles_omp.jpg $NTHREADS 2>/dev/null)
+        TIME=$(echo "$OUT" | grep "Elapsed time:" | awk '{print $3}')
+        BAND=$(echo "$OUT" | grep "band height:" | awk '{print $7}')
+        TIMES+=($TIME)
+    done
+    AVG=$(calculate_average "${TIMES[@]}")
+    if [ -z "$BASE" ]; then
+        BASE=$AVG
+    fi
+    SPEEDUP=$(echo "scale=4; $BASE / $AVG" | bc -l)
+    EFFICIENCY=$(echo "scale=4; $SPEEDUP / $NTHREADS" | bc -l)
+    echo "$NTHREADS,$BAND,$AVG,$SPEEDUP,$EFFICIENCY" >> results_tiles.csv
+    echo "  Band height: $BAND rows, Average: $AVG s, Speedup: $SPEEDUP"
+done
+
+rm -f tiles_omp.jpg
+
+echo ""
+echo "=== Band-Tiled Benchmark Complete ==="
+echo "Results saved to results_tiles.csv"
+echo ""
+cat results_tiles.csv
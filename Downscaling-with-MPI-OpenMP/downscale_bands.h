@@ -0,0 +1,55 @@
+/**
+ * Cache-Sized Row Bands
+ *
+ * Band height helpers shared by the OpenMP and streaming downscalers.
+ * A band is a run of consecutive output rows together with the input
+ * row pairs that produce them.
+ */
+
+#ifndef DOWNSCALE_BANDS_H
+#define DOWNSCALE_BANDS_H
+
+#include <stdio.h>
+#include <unistd.h>
+
+#define DEFAULT_L2_BYTES (256 * 1024)
+#define BANDS_PER_THREAD 4
+
+// Per-core L2 size in bytes, falling back to a conservative default
+static inline long detect_l2_bytes(void) {
+    long l2 = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if(l2 <= 0) {
+        FILE* f = fopen("/sys/devices/system/cpu/cpu0/cache/index2/size", "r");
+        if(f != NULL) {
+            char unit = 'K';
+            if(fscanf(f, "%ld%c", &l2, &unit) >= 1) {
+                if(unit == 'K') l2 *= 1024;
+                else if(unit == 'M') l2 *= 1024 * 1024;
+            }
+            fclose(f);
+        }
+    }
+    return l2 > 0 ? l2 : DEFAULT_L2_BYTES;
+}
+
+// Output rows whose input row pairs and output rows fill about half of L2
+static inline int l2_band_rows(int width, long l2_bytes) {
+    long bytes_per_row = 2L * width + width / 2;
+    long rows = (l2_bytes / 2) / (bytes_per_row > 0 ? bytes_per_row : 1);
+    return rows < 1 ? 1 : (int)rows;
+}
+
+// L2-sized band, capped so each thread still gets BANDS_PER_THREAD bands
+static inline int auto_band_rows(int width, int new_height, int num_threads, long l2_bytes) {
+    long rows = l2_band_rows(width, l2_bytes);
+    long balance = (new_height + (long)num_threads * BANDS_PER_THREAD - 1) /
+                   ((long)num_threads * BANDS_PER_THREAD);
+    if(rows > balance) rows = balance;
+    if(rows < 1) rows = 1;
+    return (int)rows;
+}
+
+#endif // DOWNSCALE_BANDS_H
@@ -0,0 +1,317 @@
+/**
+ * SIMD 2x2 Box Downscaling Kernel
+ *
+ * Shared by seq_main, openmp_main and mpi_main.
+ * One call turns a pair of input rows into one output row of
+ * interleaved pixels (1 = grey, 3 = RGB, 4 = RGBA bytes per pixel):
+ *
+ *   out[j][c] = (r0[2j][c] + r0[2j+1][c] + r1[2j][c] + r1[2j+1][c]) / 4
+ *
+ * Bit-exact with the scalar (sum / 4) truncation on every path:
+ *   grey: AVX-512BW / AVX2 / SSE2 (128 / 64 / 32 input bytes per row)
+ *   RGB : SSSE3, pshufb pairs same-channel bytes of neighbouring pixels
+ *   RGBA: AVX2 / SSE2, 32-bit pixels widened and added as 64-bit halves
+ *   scalar fallback and row tails for every layout
+ *
+ * The widest path the CPU supports is picked at runtime, so the
+ * makefile needs no -march flag.
+ */
+
+#ifndef DOWNSCALE_SIMD_H
+#define DOWNSCALE_SIMD_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DOWNSCALE_X86 1
+#endif
+
+typedef void (*downscale_row_fn)(const uint8_t* r0, const uint8_t* r1,
+                                 uint8_t* out, int new_width);
+
+static void downscale_row_scalar(const uint8_t* r0, const uint8_t* r1,
+                                 uint8_t* out, int new_width) {
+    for(int j = 0; j < new_width; j++) {
+        int sum = r0[2*j] + r0[2*j + 1] + r1[2*j] + r1[2*j + 1];
+        out[j] = (uint8_t)(sum / 4);
+    }
+}
+
+#ifdef DOWNSCALE_X86
+
+// SSE2: split bytes into even/odd 16-bit lanes, add, shift, pack
+__attribute__((target("sse2")))
+static void downscale_row_sse2(const uint8_t* r0, const uint8_t* r1,
+                               uint8_t* out, int new_width) {
+    const __m128i lo_mask = _mm_set1_epi16(0x00FF);
+    int j = 0;
+    for(; j + 16 <= new_width; j += 16) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(r0 + 2*j));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(r0 + 2*j + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(r1 + 2*j));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(r1 + 2*j + 16));
+
+        // Horizontal pair sums (widened to 16 bits)
+        __m128i s0 = _mm_add_epi16(_mm_and_si128(a0, lo_mask), _mm_srli_epi16(a0, 8));
+        __m128i s1 = _mm_add_epi16(_mm_and_si128(a1, lo_mask), _mm_srli_epi16(a1, 8));
+        s0 = _mm_add_epi16(s0, _mm_add_epi16(_mm_and_si128(b0, lo_mask), _mm_srli_epi16(b0, 8)));
+        s1 = _mm_add_epi16(s1, _mm_add_epi16(_mm_and_si128(b1, lo_mask), _mm_srli_epi16(b1, 8)));
+
+        // Vertical sum / 4, back to bytes (values are <= 255)
+        s0 = _mm_srli_epi16(s0, 2);
+        s1 = _mm_srli_epi16(s1, 2);
+        _mm_storeu_si128((__m128i*)(out + j), _mm_packus_epi16(s0, s1));
+    }
+    downscale_row_scalar(r0 + 2*j, r1 + 2*j, out + j, new_width - j);
+}
+
+// AVX2: maddubs with ones = widening horizontal add of byte pairs
+__attribute__((target("avx2")))
+static void downscale_row_avx2(const uint8_t* r0, const uint8_t* r1,
+                               uint8_t* out, int new_width) {
+    const __m256i ones = _mm256_set1_epi8(1);
+    int j = 0;
+    for(; j + 32 <= new_width; j += 32) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(r0 + 2*j));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(r0 + 2*j + 32));
+        __m256i b0 = _mm256_loadu_si256((const __m256i*)(r1 + 2*j));
+        __m256i b1 = _mm256_loadu_si256((const __m256i*)(r1 + 2*j + 32));
+
+        __m256i s0 = _mm256_add_epi16(_mm256_maddubs_epi16(a0, ones),
+                                      _mm256_maddubs_epi16(b0, ones));
+        __m256i s1 = _mm256_add_epi16(_mm256_maddubs_epi16(a1, ones),
+                                      _mm256_maddubs_epi16(b1, ones));
+        s0 = _mm256_srli_epi16(s0, 2);
+        s1 = _mm256_srli_epi16(s1, 2);
+
+        // packus works per 128-bit lane: restore order of the 64-bit quarters
+        __m256i packed = _mm256_packus_epi16(s0, s1);
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256((__m256i*)(out + j), packed);
+    }
+    downscale_row_scalar(r0 + 2*j, r1 + 2*j, out + j, new_width - j);
+}
+
+// AVX-512BW: same scheme on 512-bit registers
+__attribute__((target("avx512f,avx512bw")))
+static void downscale_row_avx512(const uint8_t* r0, const uint8_t* r1,
+                                 uint8_t* out, int new_width) {
+    const __m512i ones = _mm512_set1_epi8(1);
+    const __m512i order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+    int j = 0;
+    for(; j + 64 <= new_width; j += 64) {
+        __m512i a0 = _mm512_loadu_si512((const void*)(r0 + 2*j));
+        __m512i a1 = _mm512_loadu_si512((const void*)(r0 + 2*j + 64));
+        __m512i b0 = _mm512_loadu_si512((const void*)(r1 + 2*j));
+        __m512i b1 = _mm512_loadu_si512((const void*)(r1 + 2*j + 64));
+
+        __m512i s0 = _mm512_add_epi16(_mm512_maddubs_epi16(a0, ones),
+                                      _mm512_maddubs_epi16(b0, ones));
+        __m512i s1 = _mm512_add_epi16(_mm512_maddubs_epi16(a1, ones),
+                                      _mm512_maddubs_epi16(b1, ones));
+        s0 = _mm512_srli_epi16(s0, 2);
+        s1 = _mm512_srli_epi16(s1, 2);
+
+        __m512i packed = _mm512_packus_epi16(s0, s1);
+        packed = _mm512_permutexvar_epi64(order, packed);
+        _mm512_storeu_si512((void*)(out + j), packed);
+    }
+    downscale_row_scalar(r0 + 2*j, r1 + 2*j, out + j, new_width - j);
+}
+
+#endif // DOWNSCALE_X86
+
+static void downscale_row_scalar_rgb(const uint8_t* r0, const uint8_t* r1,
+                                     uint8_t* out, int new_width) {
+    for(int j = 0; j < 3 * new_width; j += 3) {
+        for(int c = 0; c < 3; c++) {
+            int sum = r0[2*j + c] + r0[2*j + 3 + c] + r1[2*j + c] + r1[2*j + 3 + c];
+            out[j + c] = (uint8_t)(sum / 4);
+        }
+    }
+}
+
+static void downscale_row_scalar_rgba(const uint8_t* r0, const uint8_t* r1,
+                                      uint8_t* out, int new_width) {
+    for(int j = 0; j < 4 * new_width; j += 4) {
+        for(int c = 0; c < 4; c++) {
+            int sum = r0[2*j + c] + r0[2*j + 4 + c] + r1[2*j + c] + r1[2*j + 4 + c];
+            out[j + c] = (uint8_t)(sum / 4);
+        }
+    }
+}
+
+#ifdef DOWNSCALE_X86
+
+// RGB: 12 input bytes (4 pixels) -> 2 output pixels per shuffle. pshufb
+// puts each channel next to the same channel of the neighbouring pixel,
+// so maddubs with ones yields the six horizontal pair sums.
+__attribute__((target("ssse3")))
+static void downscale_row_rgb_ssse3(const uint8_t* r0, const uint8_t* r1,
+                                    uint8_t* out, int new_width) {
+    const __m128i pairs = _mm_setr_epi8(0, 3, 1, 4, 2, 5, 6, 9, 7, 10, 8, 11,
+                                        -1, -1, -1, -1);
+    const __m128i compact = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13,
+                                          -1, -1, -1, -1);
+    const __m128i ones = _mm_set1_epi8(1);
+    int j = 0;
+    // The second load reads 4 bytes past the 24 used, so stop short of the row end
+    for(; 6*j + 28 <= 6*new_width; j += 4) {
+        const uint8_t* a = r0 + 6*j;
+        const uint8_t* b = r1 + 6*j;
+        __m128i s0 = _mm_add_epi16(
+            _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)a), pairs), ones),
+            _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)b), pairs), ones));
+        __m128i s1 = _mm_add_epi16(
+            _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(a + 12)), pairs), ones),
+            _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(b + 12)), pairs), ones));
+        s0 = _mm_srli_epi16(s0, 2);
+        s1 = _mm_srli_epi16(s1, 2);
+
+        // 6 + 6 result bytes, each followed by 2 padding bytes: close the gap
+        __m128i packed = _mm_shuffle_epi8(_mm_packus_epi16(s0, s1), compact);
+        uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+        _mm_storel_epi64((__m128i*)(out + 3*j), packed);
+        memcpy(out + 3*j + 8, &tail, 4);
+    }
+    downscale_row_scalar_rgb(r0 + 6*j, r1 + 6*j, out + 3*j, new_width - j);
+}
+
+// RGBA: widen 16 bytes to two 64-bit halves of 2 pixels each; the pixel
+// pairs to add are then the low and high halves of each register
+__attribute__((target("sse2")))
+static void downscale_row_rgba_sse2(const uint8_t* r0, const uint8_t* r1,
+                                    uint8_t* out, int new_width) {
+    const __m128i zero = _mm_setzero_si128();
+    int j = 0;
+    for(; j + 4 <= new_width; j += 4) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(r0 + 8*j));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(r0 + 8*j + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(r1 + 8*j));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(r1 + 8*j + 16));
+
+        // Vertical sums, pixels (0,1) (2,3) (4,5) (6,7)
+        __m128i v01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        __m128i v23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        __m128i v45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        __m128i v67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Horizontal: output pixel k = even pixel + odd pixel
+        __m128i h01 = _mm_add_epi16(_mm_unpacklo_epi64(v01, v23), _mm_unpackhi_epi64(v01, v23));
+        __m128i h23 = _mm_add_epi16(_mm_unpacklo_epi64(v45, v67), _mm_unpackhi_epi64(v45, v67));
+        h01 = _mm_srli_epi16(h01, 2);
+        h23 = _mm_srli_epi16(h23, 2);
+        _mm_storeu_si128((__m128i*)(out + 4*j), _mm_packus_epi16(h01, h23));
+    }
+    downscale_row_scalar_rgba(r0 + 8*j, r1 + 8*j, out + 4*j, new_width - j);
+}
+
+// RGBA on 256-bit registers; the unpacks work per 128-bit lane, so the
+// packed result comes out as pixel pairs 01 45 23 67 and is permuted back
+__attribute__((target("avx2")))
+static void downscale_row_rgba_avx2(const uint8_t* r0, const uint8_t* r1,
+                                    uint8_t* out, int new_width) {
+    const __m256i zero = _mm256_setzero_si256();
+    int j = 0;
+    for(; j + 8 <= new_width; j += 8) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(r0 + 8*j));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(r0 + 8*j + 32));
+        __m256i b0 = _mm256_loadu_si256((const __m256i*)(r1 + 8*j));
+        __m256i b1 = _mm256_loadu_si256((const __m256i*)(r1 + 8*j + 32));
+
+        __m256i lo0 = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero), _mm256_unpacklo_epi8(b0, zero));
+        __m256i hi0 = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero), _mm256_unpackhi_epi8(b0, zero));
+        __m256i lo1 = _mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero), _mm256_unpacklo_epi8(b1, zero));
+        __m256i hi1 = _mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero), _mm256_unpackhi_epi8(b1, zero));
+
+        __m256i h0 = _mm256_add_epi16(_mm256_unpacklo_epi64(lo0, hi0), _mm256_unpackhi_epi64(lo0, hi0));
+        __m256i h1 = _mm256_add_epi16(_mm256_unpacklo_epi64(lo1, hi1), _mm256_unpackhi_epi64(lo1, hi1));
+        h0 = _mm256_srli_epi16(h0, 2);
+        h1 = _mm256_srli_epi16(h1, 2);
+
+        __m256i packed = _mm256_packus_epi16(h0, h1);
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256((__m256i*)(out + 4*j), packed);
+    }
+    downscale_row_scalar_rgba(r0 + 8*j, r1 + 8*j, out + 4*j, new_width - j);
+}
+
+#endif // DOWNSCALE_X86
+
+// Pick the widest supported kernel for 1, 3 or 4 interleaved channels
+// (name is for reporting); NULL for any other channel count
+static downscale_row_fn downscale_select(int channels, const char** name) {
+    const char* isa = "scalar";
+    downscale_row_fn fn = NULL;
+#ifdef DOWNSCALE_X86
+    __builtin_cpu_init();
+#endif
+    if(channels == 3) {
+        fn = downscale_row_scalar_rgb;
+#ifdef DOWNSCALE_X86
+        if(__builtin_cpu_supports("ssse3")) {
+            isa = "SSSE3";
+            fn = downscale_row_rgb_ssse3;
+        }
+#endif
+    } else if(channels == 4) {
+        fn = downscale_row_scalar_rgba;
+#ifdef DOWNSCALE_X86
+        if(__builtin_cpu_supports("avx2")) {
+            isa = "AVX2";
+            fn = downscale_row_rgba_avx2;
+        } else if(__builtin_cpu_supports("sse2")) {
+            isa = "SSE2";
+            fn = downscale_row_rgba_sse2;
+        }
+#endif
+    } else if(channels == 1) {
+        fn = downscale_row_scalar;
+#ifdef DOWNSCALE_X86
+        if(__builtin_cpu_supports("avx512bw")) {
+            isa = "AVX-512BW";
+            fn = downscale_row_avx512;
+        } else if(__builtin_cpu_supports("avx2")) {
+            isa = "AVX2";
+            fn = downscale_row_avx2;
+        } else if(__builtin_cpu_supports("sse2")) {
+            isa = "SSE2";
+            fn = downscale_row_sse2;
+        }
+#endif
+    }
+    if(name != NULL) *name = isa;
+    return fn;
+}
+
+// Take --channels <1|3|4> out of argv; 0 (the default) keeps the file's
+// own layout. Returns 0, or -1 on a bad value.
+static inline int downscale_parse_channels(int* argc, char** argv, int* channels) {
+    *channels = 0;
+    int kept = 1;
+    for(int a = 1; a < *argc; a++) {
+        if(strcmp(argv[a], "--channels") != 0) {
+            argv[kept++] = argv[a];
+            continue;
+        }
+        if(a + 1 >= *argc) return -1;
+        *channels = atoi(argv[++a]);
+        if(*channels != 1 && *channels != 3 && *channels != 4) return -1;
+    }
+    *argc = kept;
+    argv[kept] = NULL;
+    return 0;
+}
+
+// Layout to decode a file with `native` channels into: grey stays grey,
+// grey + alpha becomes RGBA, unless --channels asked for one explicitly
+static inline int downscale_load_channels(int requested, int native) {
+    if(requested != 0) return requested;
+    if(native == 2) return 4;
+    return (native == 1 || native == 3 || native == 4) ? native : 3;
+}
+
+#endif // DOWNSCALE_SIMD_H
@@ -0,0 +1,61 @@
+/**
+ * Row-Pair Decomposition Across Ranks
+ *
+ * Shared by mpi_main and hybrid_main for the 2x path. The height / 2
+ * input row pairs are split as evenly as possible: every rank gets
+ * pairs / size, the first (pairs % size) ranks one more. Root builds
+ * the per-rank tables once; all counts and displacements are in bytes
+ * (pixels times channels), ready for MPI_Scatterv / MPI_Gatherv.
+ */
+
+#ifndef DOWNSCALE_SPLIT_H
+#define DOWNSCALE_SPLIT_H
+
+#include <stdlib.h>
+
+typedef struct {
+    int* pair_counts;   // row pairs per rank
+    int* sendcounts;    // input bytes per rank (2 rows per pair)
+    int* displs;        // first input byte per rank
+    int* recvcounts;    // output bytes per rank (1 row per pair)
+    int* recvdispls;    // first output byte per rank
+} Row_Pair_Split;
+
+static inline void row_pair_split_free(Row_Pair_Split* s) {
+    free(s->pair_counts);
+    free(s->sendcounts);
+    free(s->displs);
+    free(s->recvcounts);
+    free(s->recvdispls);
+    s->pair_counts = s->sendcounts = s->displs = s->recvcounts = s->recvdispls = NULL;
+}
+
+// Build the tables for `size` ranks; returns 0, or -1 if out of memory
+static inline int row_pair_split_init(Row_Pair_Split* s, int width, int height,
+                                      int channels, int size) {
+    s->pair_counts = (int*)malloc(size * sizeof(int));
+    s->sendcounts = (int*)malloc(size * sizeof(int));
+    s->displs = (int*)malloc(size * sizeof(int));
+    s->recvcounts = (int*)malloc(size * sizeof(int));
+    s->recvdispls = (int*)malloc(size * sizeof(int));
+    if(s->pair_counts == NULL || s->sendcounts == NULL || s->displs == NULL ||
+       s->recvcounts == NULL || s->recvdispls == NULL) {
+        row_pair_split_free(s);
+        return -1;
+    }
+
+    int pairs = height / 2;
+    int current_pair = 0;
+    for(int i = 0; i < size; i++) {
+        s->pair_counts[i] = pairs / size + (i < pairs % size ? 1 : 0);
+
+        s->sendcounts[i] = 2 * s->pair_counts[i] * width * channels;
+        s->displs[i] = 2 * current_pair * width * channels;
+        s->recvcounts[i] = s->pair_counts[i] * (width / 2) * channels;
+        s->recvdispls[i] = current_pair * (width / 2) * channels;
+        current_pair += s->pair_counts[i];
+    }
+    return 0;
+}
+
+#endif // DOWNSCALE_SPLIT_H
@@ -0,0 +1,214 @@
+/**
+ * Hybrid MPI + OpenMP Image Downscaling
+ *
+ * Usage: mpirun -np <num_ranks> ./hybrid_main <aybu.jpg> <aybu_hybrid.jpg>
+ *            [threads_per_rank] [band_rows] [--channels 1|3|4]
+ *
+ * Meant for one rank per socket or node. Row pairs are split across
+ * ranks with the same tables as mpi_main (downscale_split.h); inside a
+ * rank, an OpenMP team works through L2-sized bands of its output rows
+ * as in openmp_main. Ranks and threads are set independently
+ * (threads_per_rank defaults to OMP_NUM_THREADS). Only the master
+ * thread calls MPI, so MPI is initialised with MPI_THREAD_FUNNELED.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <mpi.h>
+#include <omp.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "downscale_simd.h"
+#include "downscale_split.h"
+#include "downscale_bands.h"
+
+
+// This rank's row pairs, downscaled by its thread team in bands of output rows
+void hybrid_downscaling(uint8_t* local_input, uint8_t* local_output, int width,
+                        int local_rows, int channels, int num_threads, int band_rows) {
+    int new_width = width / 2;
+    int local_new_rows = local_rows / 2;
+    int num_bands = (local_new_rows + band_rows - 1) / band_rows;
+    size_t in_stride = (size_t)width * channels;
+    size_t out_stride = (size_t)new_width * channels;
+    downscale_row_fn downscale_row = downscale_select(channels, NULL);
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+    for(int b = 0; b < num_bands; b++) {
+        int row_begin = b * band_rows;
+        int row_end = row_begin + band_rows;
+        if(row_end > local_new_rows) row_end = local_new_rows;
+
+        for(int i = row_begin; i < row_end; i++) {
+            downscale_row(local_input + (2*i) * in_stride,
+                          local_input + (2*i + 1) * in_stride,
+                          local_output + i * out_stride, new_width);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rank, size, provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    int channels;
+    if(downscale_parse_channels(&argc, argv, &channels) != 0 || argc < 3 || argc > 5) {
+        if(rank == 0) {
+            printf("Usage: mpirun -np <num_ranks> %s <aybu.jpg> <aybu_hybrid.jpg> "
+                   "[threads_per_rank] [band_rows] [--channels 1|3|4]\n", argv[0]);
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    if(provided < MPI_THREAD_FUNNELED) {
+        if(rank == 0) {
+            printf("Error: MPI library does not provide MPI_THREAD_FUNNELED\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    int num_threads = omp_get_max_threads();
+    if(argc >= 4) {
+        num_threads = atoi(argv[3]);
+    }
+    int band_rows = 0;
+    if(argc == 5) {
+        band_rows = atoi(argv[4]);
+    }
+    if(num_threads <= 0 || band_rows < 0) {
+        if(rank == 0) {
+            printf("Error: Invalid number of threads or band height\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    int width, height;
+    uint8_t* input_image = NULL;
+    uint8_t* output_image = NULL;
+
+    if(rank == 0) {
+        int bpp = 0;
+        stbi_info(argv[1], &width, &height, &bpp);
+        channels = downscale_load_channels(channels, bpp);
+        input_image = stbi_load(argv[1], &width, &height, &bpp, channels);
+
+        if(input_image == NULL) {
+            printf("Error: Could not load image %s\n", argv[1]);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+
+        const char* isa;
+        downscale_select(channels, &isa);
+
+        printf("Width: %d  Height: %d\n", width, height);
+        printf("Input: %s, Output: %s\n", argv[1], argv[2]);
+        printf("Number of processes: %d\n", size);
+        printf("Threads per process: %d\n", num_threads);
+        printf("Channels: %d\n", channels);
+        printf("SIMD kernel: %s\n", isa);
+
+        if(width % 2 != 0 || height % 2 != 0) {
+            printf("Warning: Image dimensions should be even for 2x downscaling\n");
+        }
+    }
+
+    MPI_Bcast(&width, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&height, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&channels, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    // Root owns the row-pair layout (downscale_split.h) and hands each
+    // rank its share with MPI_Scatter
+    Row_Pair_Split split = {0};
+    if(rank == 0 && row_pair_split_init(&split, width, height, channels, size) != 0) {
+        printf("Error: Could not allocate decomposition tables\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    int local_pairs;
+    MPI_Scatter(split.pair_counts, 1, MPI_INT, &local_pairs, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    int local_rows = 2 * local_pairs;
+    int new_width = width / 2;
+
+    uint8_t* local_input = (uint8_t*)malloc((size_t)local_rows * width * channels + 1);
+    uint8_t* local_output = (uint8_t*)malloc((size_t)local_pairs * new_width * channels + 1);
+    if(local_input == NULL || local_output == NULL) {
+        printf("Process %d: Error allocating memory\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    // Bands sized to the per-core L2 and this rank's share of rows
+    if(band_rows == 0) {
+        band_rows = auto_band_rows(width * channels, local_pairs > 0 ? local_pairs : 1,
+                                   num_threads, detect_l2_bytes());
+    }
+    if(rank == 0) {
+        printf("Rank 0 band height: %d output rows\n", band_rows);
+    }
+
+    // Start every rank's thread team before timing
+    #pragma omp parallel num_threads(num_threads)
+    { }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start_time = MPI_Wtime();
+
+    MPI_Scatterv(input_image, split.sendcounts, split.displs, MPI_UNSIGNED_CHAR,
+                 local_input, local_rows * width * channels, MPI_UNSIGNED_CHAR,
+                 0, MPI_COMM_WORLD);
+
+    double compute_start = MPI_Wtime();
+    hybrid_downscaling(local_input, local_output, width, local_rows, channels,
+                       num_threads, band_rows);
+    double compute_time = MPI_Wtime() - compute_start;
+
+    if(rank == 0) {
+        int new_height = height / 2;
+        output_image = (uint8_t*)malloc((size_t)new_width * new_height * channels);
+        if(output_image == NULL) {
+            printf("Error: Could not allocate output buffer\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+
+    MPI_Gatherv(local_output, local_pairs * new_width * channels, MPI_UNSIGNED_CHAR,
+                output_image, split.recvcounts, split.recvdispls, MPI_UNSIGNED_CHAR,
+                0, MPI_COMM_WORLD);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double end_time = MPI_Wtime();
+
+    double slowest_compute;
+    MPI_Reduce(&compute_time, &slowest_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if(rank == 0) {
+        printf("Downscale time (slowest rank): %lf seconds\n", slowest_compute);
+        printf("Elapsed time: %lf seconds\n", end_time - start_time);
+
+        int new_height = height / 2;
+        int result = stbi_write_jpg(argv[2], new_width, new_height, channels,
+                                    output_image, 100);
+
+        if(!result) {
+            printf("Error: Could not save output image\n");
+        }
+
+        stbi_image_free(input_image);
+        free(output_image);
+        row_pair_split_free(&split);
+    }
+
+    free(local_input);
+    free(local_output);
+
+    MPI_Finalize();
+    return 0;
+}
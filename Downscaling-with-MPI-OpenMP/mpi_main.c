@@ -1,7 +1,25 @@
 /**
  * Parallel Image Downscaling with MPI
  * 
- * Usage: mpirun -np <num_processes> ./mpi_main <aybu.jpg> <aybu_mpi.jpg>
+ * Usage: mpirun -np <num_processes> ./mpi_main <aybu.jpg> <aybu_mpi.jpg> [--channels 1|3|4]
+ *            [--scale <f> | --size <WxH>] [--filter box|bilinear|bicubic|lanczos3]
+ *            [--chunk-rows <n>]
+ *
+ * Resampling options switch from the 2x2 box kernel to the separable
+ * filters in resample.h. Output rows are then split evenly and each rank
+ * receives exactly the input rows its filter windows cover. Pixels keep
+ * the file's channel layout unless --channels is given; every scatter and
+ * gather count is in bytes, i.e. pixels times channels.
+ *
+ * With a raw PGM/PPM input and a .pgm/.ppm output, rank 0 does not load
+ * and scatter the image: every rank reads its own row slab and writes its
+ * own output slab with collective MPI-IO.
+ *
+ * --chunk-rows pipelines the 2x path: each rank's slab arrives and
+ * returns in rounds of n row pairs (nonblocking scatter / gather), so
+ * communication of one round overlaps the downscale of another. Overlap
+ * efficiency is the share of a rank's pipeline time spent computing
+ * rather than waiting on MPI; 100% means communication was fully hidden.
  */
 
 #include <stdio.h>
@@ -13,25 +31,388 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image.h"
 #include "stb_image_write.h"
+#include "downscale_simd.h"
+#include "downscale_split.h"
+#include "resample.h"
+#include "pnm_io.h"
 
-#define CHANNEL_NUM 1
 
 
 void parallel_downscaling(uint8_t* local_input, uint8_t* local_output,
-                         int width, int local_rows) {
+                         int width, int local_rows, int channels) {
     int new_width = width / 2;
     int local_new_rows = local_rows / 2;
+    size_t in_stride = (size_t)width * channels;
+    size_t out_stride = (size_t)new_width * channels;
+    downscale_row_fn downscale_row = downscale_select(channels, NULL);
     
     for(int i = 0; i < local_new_rows; i++) {
-        for(int j = 0; j < new_width; j++) {
-            int sum = 0;
-            sum += local_input[(2*i) * width + (2*j)];
-            sum += local_input[(2*i) * width + (2*j + 1)];
-            sum += local_input[(2*i + 1) * width + (2*j)];
-            sum += local_input[(2*i + 1) * width + (2*j + 1)];
-            local_output[i * new_width + j] = (uint8_t)(sum / 4);
+        downscale_row(local_input + (2*i) * in_stride,
+                      local_input + (2*i + 1) * in_stride,
+                      local_output + i * out_stride, new_width);
+    }
+}
+
+// Row pairs a rank holds in round k of the pipeline (0 once it runs out)
+static inline int chunk_pairs(int rank_pairs, int k, int chunk_rows) {
+    int c = rank_pairs - k * chunk_rows;
+    if(c < 0) c = 0;
+    return c < chunk_rows ? c : chunk_rows;
+}
+
+// Pipelined 2x downscaling: every rank's slab is sent in rounds of
+// chunk_rows row pairs with MPI_Iscatterv into two alternating buffers,
+// so round k+1 is in flight while round k is downscaled, and each
+// finished round goes back with MPI_Igatherv while later rounds compute.
+// pair_counts is only read on root. Reports this rank's compute time and
+// the time it sat in MPI_Wait (communication that was not hidden).
+void pipelined_downscaling(uint8_t* input_image, uint8_t* output_image,
+                           const int* pair_counts, int local_pairs, uint8_t* local_output,
+                           int width, int height, int channels, int chunk_rows,
+                           int rank, int size, double* compute_time, double* wait_time) {
+    int new_width = width / 2;
+    int pairs = height / 2;
+    // Rank 0 holds the most pairs, so its share fixes the number of rounds
+    int rounds = ((pairs + size - 1) / size + chunk_rows - 1) / chunk_rows;
+    size_t in_row = (size_t)width * channels;
+    size_t out_row = (size_t)new_width * channels;
+
+    // Per-round count and displacement tables; nonblocking collectives
+    // need them untouched until they complete, so each round has its own
+    int* tables = NULL;
+    int* sendcounts = NULL;
+    int* displs = NULL;
+    int* recvcounts = NULL;
+    int* recvdispls = NULL;
+    if(rank == 0) {
+        tables = (int*)malloc((size_t)4 * rounds * size * sizeof(int) + 1);
+        if(tables == NULL) {
+            printf("Error: Could not allocate pipeline tables\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        sendcounts = tables;
+        displs = tables + (size_t)rounds * size;
+        recvcounts = tables + (size_t)2 * rounds * size;
+        recvdispls = tables + (size_t)3 * rounds * size;
+        int first = 0;
+        for(int r = 0; r < size; r++) {
+            for(int k = 0; k < rounds; k++) {
+                int c = chunk_pairs(pair_counts[r], k, chunk_rows);
+                int p = c > 0 ? first + k * chunk_rows : first;
+                sendcounts[k * size + r] = 2 * c * width * channels;
+                displs[k * size + r] = 2 * p * width * channels;
+                recvcounts[k * size + r] = c * new_width * channels;
+                recvdispls[k * size + r] = p * new_width * channels;
+            }
+            first += pair_counts[r];
+        }
+    }
+
+    uint8_t* in_buf[2];
+    in_buf[0] = (uint8_t*)malloc(2 * chunk_rows * in_row + 1);
+    in_buf[1] = (uint8_t*)malloc(2 * chunk_rows * in_row + 1);
+    MPI_Request scatter_req[2];
+    MPI_Request* gather_req = (MPI_Request*)malloc((size_t)rounds * sizeof(MPI_Request) + 1);
+    if(in_buf[0] == NULL || in_buf[1] == NULL || gather_req == NULL) {
+        printf("Process %d: Error allocating pipeline buffers\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    *compute_time = 0.0;
+    *wait_time = 0.0;
+
+    // All ranks post the same collectives in the same order: scatter 0,
+    // then per round scatter k+1 and gather k
+    if(rounds > 0) {
+        MPI_Iscatterv(input_image, sendcounts, displs, MPI_UNSIGNED_CHAR,
+                      in_buf[0], 2 * chunk_pairs(local_pairs, 0, chunk_rows) * (int)in_row,
+                      MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD, &scatter_req[0]);
+    }
+
+    for(int k = 0; k < rounds; k++) {
+        int cur = k % 2;
+        int next = (k + 1) % 2;
+        int c = chunk_pairs(local_pairs, k, chunk_rows);
+
+        // in_buf[next] was consumed by round k-1, which has finished
+        if(k + 1 < rounds) {
+            MPI_Iscatterv(input_image,
+                          rank == 0 ? sendcounts + (k + 1) * size : NULL,
+                          rank == 0 ? displs + (k + 1) * size : NULL, MPI_UNSIGNED_CHAR,
+                          in_buf[next], 2 * chunk_pairs(local_pairs, k + 1, chunk_rows) * (int)in_row,
+                          MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD, &scatter_req[next]);
+        }
+
+        double t = MPI_Wtime();
+        MPI_Wait(&scatter_req[cur], MPI_STATUS_IGNORE);
+        *wait_time += MPI_Wtime() - t;
+
+        // Without an asynchronous progress thread, MPI moves the next
+        // round only inside MPI calls; a test here gets it started
+        if(k + 1 < rounds) {
+            int flag;
+            MPI_Test(&scatter_req[next], &flag, MPI_STATUS_IGNORE);
+        }
+
+        uint8_t* out = c > 0 ? local_output + (size_t)k * chunk_rows * out_row : local_output;
+        t = MPI_Wtime();
+        parallel_downscaling(in_buf[cur], out, width, 2 * c, channels);
+        *compute_time += MPI_Wtime() - t;
+
+        MPI_Igatherv(out, c * (int)out_row, MPI_UNSIGNED_CHAR,
+                     output_image,
+                     rank == 0 ? recvcounts + k * size : NULL,
+                     rank == 0 ? recvdispls + k * size : NULL, MPI_UNSIGNED_CHAR,
+                     0, MPI_COMM_WORLD, &gather_req[k]);
+    }
+
+    double t = MPI_Wtime();
+    MPI_Waitall(rounds, gather_req, MPI_STATUSES_IGNORE);
+    *wait_time += MPI_Wtime() - t;
+
+    free(in_buf[0]);
+    free(in_buf[1]);
+    free(gather_req);
+    free(tables);
+}
+
+// Take --chunk-rows <n> out of argv; 0 (the default) keeps the single
+// scatter / compute / gather. Returns 0, or -1 on a bad value.
+static int parse_chunk_rows(int* argc, char** argv, int* chunk_rows) {
+    *chunk_rows = 0;
+    int kept = 1;
+    for(int a = 1; a < *argc; a++) {
+        if(strcmp(argv[a], "--chunk-rows") != 0) {
+            argv[kept++] = argv[a];
+            continue;
+        }
+        if(a + 1 >= *argc) return -1;
+        *chunk_rows = atoi(argv[++a]);
+        if(*chunk_rows <= 0) return -1;
+    }
+    *argc = kept;
+    argv[kept] = NULL;
+    return 0;
+}
+
+// Arbitrary-ratio downscaling across ranks; the result is gathered at root
+void mpi_resample(uint8_t* input_image, uint8_t* output_image, int width, int height,
+                  int new_width, int new_height, int channels, resample_filter filter,
+                  int rank, int size) {
+    Resample_Coeffs cx = {0}, cy = {0};
+    if(resample_coeffs_init(&cx, width, new_width, filter) != 0 ||
+       resample_coeffs_init(&cy, height, new_height, filter) != 0) {
+        printf("Process %d: Error allocating filter tables\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    
+    // Output rows per rank differ by at most one
+    int* row_begin = (int*)malloc((size + 1) * sizeof(int));
+    int* recvcounts = (int*)malloc(size * sizeof(int));
+    int* recvdispls = (int*)malloc(size * sizeof(int));
+    if(row_begin == NULL || recvcounts == NULL || recvdispls == NULL) {
+        printf("Process %d: Error allocating memory\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    for(int r = 0; r <= size; r++) {
+        row_begin[r] = (int)((long)new_height * r / size);
+    }
+    for(int r = 0; r < size; r++) {
+        recvcounts[r] = (row_begin[r + 1] - row_begin[r]) * new_width * channels;
+        recvdispls[r] = row_begin[r] * new_width * channels;
+    }
+    
+    // Input rows covered by this rank's filter windows (they overlap
+    // between neighbours, so they are sent point to point, not scattered)
+    int first, last;
+    resample_input_rows(&cy, row_begin[rank], row_begin[rank + 1], &first, &last);
+    size_t row_bytes = (size_t)width * channels;
+    uint8_t* local_input = (uint8_t*)malloc((last - first) * row_bytes + 1);
+    uint8_t* local_output = (uint8_t*)malloc((size_t)recvcounts[rank] + 1);
+    float* tmp = (float*)malloc(row_bytes * sizeof(float));
+    if(local_input == NULL || local_output == NULL || tmp == NULL) {
+        printf("Process %d: Error allocating memory\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    
+    if(rank == 0) {
+        for(int r = 1; r < size; r++) {
+            int f, l;
+            resample_input_rows(&cy, row_begin[r], row_begin[r + 1], &f, &l);
+            if(l > f) {
+                MPI_Send(input_image + (size_t)f * row_bytes, (int)((l - f) * row_bytes),
+                         MPI_UNSIGNED_CHAR, r, 0, MPI_COMM_WORLD);
+            }
         }
+        memcpy(local_input, input_image + (size_t)first * row_bytes, (last - first) * row_bytes);
+    } else if(last > first) {
+        MPI_Recv(local_input, (int)((last - first) * row_bytes), MPI_UNSIGNED_CHAR,
+                 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
     }
+    
+    resample_rows(local_input, width, channels, first, &cx, &cy,
+                  row_begin[rank], row_begin[rank + 1], local_output, tmp);
+    
+    MPI_Gatherv(local_output, recvcounts[rank], MPI_UNSIGNED_CHAR,
+                output_image, recvcounts, recvdispls, MPI_UNSIGNED_CHAR,
+                0, MPI_COMM_WORLD);
+    
+    free(local_input);
+    free(local_output);
+    free(tmp);
+    free(row_begin);
+    free(recvcounts);
+    free(recvdispls);
+    resample_coeffs_free(&cx);
+    resample_coeffs_free(&cy);
+}
+
+// Raw PGM/PPM path: each rank reads the input rows it needs and writes its
+// output rows with collective MPI-IO, so no pixel data passes through
+// rank 0. Returns the exit code.
+int mpi_io_downscaling(const char* in_path, const char* out_path, int channels,
+                       const Resample_Options* opt, int rank, int size) {
+    // Every rank parses the (small) header itself instead of a broadcast
+    int width = 0, height = 0, maxval = 0, file_channels = 0;
+    long header_bytes = -1;
+    FILE* fp = fopen(in_path, "rb");
+    if(fp != NULL) {
+        if(pnm_read_header(fp, &width, &height, &maxval, &file_channels) == 0) {
+            header_bytes = ftell(fp);
+        }
+        fclose(fp);
+    }
+    if(header_bytes < 0 || (channels != 0 && channels != file_channels)) {
+        if(rank == 0) {
+            printf("Error: %s output needs an 8-bit raw PGM/PPM input in the same layout\n",
+                   out_path);
+        }
+        return 1;
+    }
+    channels = file_channels;
+    
+    int new_width = width / 2;
+    int new_height = height / 2;
+    if(opt->enabled && resample_output_size(opt, width, height, &new_width, &new_height) != 0) {
+        if(rank == 0) printf("Error: Output size must be between 1x1 and the input size\n");
+        return 1;
+    }
+    if(new_width == 0 || new_height == 0) {
+        if(rank == 0) printf("Error: Image is too small to downscale\n");
+        return 1;
+    }
+    
+    if(rank == 0) {
+        printf("Width: %d  Height: %d\n", width, height);
+        printf("Input: %s, Output: %s\n", in_path, out_path);
+        printf("Number of processes: %d\n", size);
+        printf("Channels: %d\n", channels);
+        printf("I/O: collective MPI-IO row slabs\n");
+        if(opt->enabled) {
+            printf("Resampling to %dx%d with %s filter\n", new_width, new_height,
+                   resample_filter_name(opt->filter));
+        } else {
+            const char* isa;
+            downscale_select(channels, &isa);
+            printf("SIMD kernel: %s\n", isa);
+        }
+    }
+    
+    // Output rows per rank differ by at most one
+    int row_begin = (int)((long)new_height * rank / size);
+    int row_end = (int)((long)new_height * (rank + 1) / size);
+    int first = 2 * row_begin;
+    int last = 2 * row_end;
+    
+    Resample_Coeffs cx = {0}, cy = {0};
+    if(opt->enabled) {
+        if(resample_coeffs_init(&cx, width, new_width, opt->filter) != 0 ||
+           resample_coeffs_init(&cy, height, new_height, opt->filter) != 0) {
+            printf("Process %d: Error allocating filter tables\n", rank);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        resample_input_rows(&cy, row_begin, row_end, &first, &last);
+    }
+    
+    // Whole rows as the transfer unit keeps counts in int range for big slabs
+    size_t in_row = (size_t)width * channels;
+    size_t out_row = (size_t)new_width * channels;
+    MPI_Datatype in_row_type, out_row_type;
+    MPI_Type_contiguous((int)in_row, MPI_UNSIGNED_CHAR, &in_row_type);
+    MPI_Type_contiguous((int)out_row, MPI_UNSIGNED_CHAR, &out_row_type);
+    MPI_Type_commit(&in_row_type);
+    MPI_Type_commit(&out_row_type);
+    
+    uint8_t* local_input = (uint8_t*)malloc((last - first) * in_row + 1);
+    uint8_t* local_output = (uint8_t*)malloc((row_end - row_begin) * out_row + 1);
+    float* tmp = opt->enabled ? (float*)malloc(in_row * sizeof(float)) : NULL;
+    if(local_input == NULL || local_output == NULL || (opt->enabled && tmp == NULL)) {
+        printf("Process %d: Error allocating memory\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    
+    char out_header[64];
+    int out_header_bytes = pnm_format_header(out_header, sizeof(out_header),
+                                             new_width, new_height, maxval, channels);
+    
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = MPI_Wtime();
+    
+    MPI_File fin;
+    if(MPI_File_open(MPI_COMM_WORLD, in_path, MPI_MODE_RDONLY, MPI_INFO_NULL, &fin) != MPI_SUCCESS) {
+        printf("Process %d: Could not open %s with MPI-IO\n", rank, in_path);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_File_read_at_all(fin, (MPI_Offset)header_bytes + (MPI_Offset)first * in_row,
+                         local_input, last - first, in_row_type, MPI_STATUS_IGNORE);
+    MPI_File_close(&fin);
+    
+    double t1 = MPI_Wtime();
+    
+    if(opt->enabled) {
+        resample_rows(local_input, width, channels, first, &cx, &cy,
+                      row_begin, row_end, local_output, tmp);
+    } else {
+        parallel_downscaling(local_input, local_output, width, last - first, channels);
+    }
+    
+    double t2 = MPI_Wtime();
+    
+    MPI_File fout;
+    if(MPI_File_open(MPI_COMM_WORLD, out_path, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                     MPI_INFO_NULL, &fout) != MPI_SUCCESS) {
+        printf("Process %d: Could not create %s with MPI-IO\n", rank, out_path);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    // Set the exact size so an older, larger file leaves no stale tail
+    MPI_File_set_size(fout, (MPI_Offset)out_header_bytes + (MPI_Offset)new_height * out_row);
+    if(rank == 0) {
+        MPI_File_write_at(fout, 0, out_header, out_header_bytes, MPI_CHAR, MPI_STATUS_IGNORE);
+    }
+    MPI_File_write_at_all(fout, (MPI_Offset)out_header_bytes + (MPI_Offset)row_begin * out_row,
+                          local_output, row_end - row_begin, out_row_type, MPI_STATUS_IGNORE);
+    MPI_File_close(&fout);
+    
+    double t3 = MPI_Wtime();
+    
+    // Slowest rank per phase and overall
+    double phase[4] = {t1 - t0, t2 - t1, t3 - t2, t3 - t0};
+    double slowest[4];
+    MPI_Reduce(phase, slowest, 4, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    if(rank == 0) {
+        printf("Read: %lf  Downscale: %lf  Write: %lf seconds\n",
+               slowest[0], slowest[1], slowest[2]);
+        printf("Elapsed time: %lf seconds\n", slowest[3]);
+    }
+    
+    MPI_Type_free(&in_row_type);
+    MPI_Type_free(&out_row_type);
+    free(local_input);
+    free(local_output);
+    free(tmp);
+    resample_coeffs_free(&cx);
+    resample_coeffs_free(&cy);
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
@@ -40,22 +421,40 @@ int main(int argc, char* argv[]) {
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
     
-    if(argc != 3) {
+    Resample_Options opt;
+    int channels, chunk_rows;
+    if(downscale_parse_channels(&argc, argv, &channels) != 0 ||
+       parse_chunk_rows(&argc, argv, &chunk_rows) != 0 ||
+       resample_parse_options(&argc, argv, &opt) != 0 || argc != 3) {
         if(rank == 0) {
-            printf("Usage: mpirun -np <num_processes> %s <aybu.jpg> <aybu_mpi.jpg>\n", argv[0]);
+            printf("Usage: mpirun -np <num_processes> %s <aybu.jpg> <aybu_mpi.jpg> "
+                   "[--channels 1|3|4] [--scale <f> | --size <WxH>] [--filter box|bilinear|bicubic|lanczos3] "
+                   "[--chunk-rows <n>]\n", argv[0]);
         }
         MPI_Finalize();
         return 1;
     }
     
+    if(rank == 0 && chunk_rows > 0 && (opt.enabled || pnm_is_path(argv[2]))) {
+        printf("Note: --chunk-rows only applies to 2x downscaling with a root scatter\n");
+    }
+    
+    if(pnm_is_path(argv[2])) {
+        int status = mpi_io_downscaling(argv[1], argv[2], channels, &opt, rank, size);
+        MPI_Finalize();
+        return status;
+    }
+    
     int width, height;
     uint8_t* input_image = NULL;
     uint8_t* output_image = NULL;
     
     
     if(rank == 0) {
-        int bpp;
-        input_image = stbi_load(argv[1], &width, &height, &bpp, CHANNEL_NUM);
+        int bpp = 0;
+        stbi_info(argv[1], &width, &height, &bpp);
+        channels = downscale_load_channels(channels, bpp);
+        input_image = stbi_load(argv[1], &width, &height, &bpp, channels);
         
         if(input_image == NULL) {
             printf("Error: Could not load image %s\n", argv[1]);
@@ -65,105 +464,156 @@ int main(int argc, char* argv[]) {
         printf("Width: %d  Height: %d\n", width, height);
         printf("Input: %s, Output: %s\n", argv[1], argv[2]);
         printf("Number of processes: %d\n", size);
+        printf("Channels: %d\n", channels);
         
-        
-        if(height % (2 * size) != 0) {
-            printf("Warning: Height should be divisible by %d for optimal load balancing\n", 2 * size);
+        if(!opt.enabled) {
+            const char* isa;
+            downscale_select(channels, &isa);
+            printf("SIMD kernel: %s\n", isa);
+            
+            if(width % 2 != 0 || height % 2 != 0) {
+                printf("Warning: Image dimensions should be even for 2x downscaling\n");
+            }
         }
     }
     
     // Broadcast dimensions to all processes
     MPI_Bcast(&width, 1, MPI_INT, 0, MPI_COMM_WORLD);
     MPI_Bcast(&height, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&channels, 1, MPI_INT, 0, MPI_COMM_WORLD);
     
-    // Calculate rows per process 
-    int rows_per_process = (height / size);
-    if(rows_per_process % 2 != 0) {
-        rows_per_process = (rows_per_process / 2) * 2;
-    }
-    
-    // Calculate send counts and displacements for scatterv
-    int* sendcounts = NULL;
-    int* displs = NULL;
-    int* recvcounts = NULL;
-    int* recvdispls = NULL;
-    
-    if(rank == 0) {
-        sendcounts = (int*)malloc(size * sizeof(int));
-        displs = (int*)malloc(size * sizeof(int));
-        recvcounts = (int*)malloc(size * sizeof(int));
-        recvdispls = (int*)malloc(size * sizeof(int));
+    if(opt.enabled) {
+        int new_width, new_height;
+        if(resample_output_size(&opt, width, height, &new_width, &new_height) != 0) {
+            if(rank == 0) {
+                printf("Error: Output size must be between 1x1 and the input size\n");
+                stbi_image_free(input_image);
+            }
+            MPI_Finalize();
+            return 1;
+        }
         
-        int current_row = 0;
-        for(int i = 0; i < size; i++) {
-            int local_rows = rows_per_process;
-            if(i == size - 1) {
-                local_rows = height - current_row;
-                if(local_rows % 2 != 0) local_rows--;
+        if(rank == 0) {
+            printf("Resampling to %dx%d with %s filter\n", new_width, new_height,
+                   resample_filter_name(opt.filter));
+            output_image = (uint8_t*)malloc((size_t)new_width * new_height * channels);
+            if(output_image == NULL) {
+                printf("Error: Could not allocate output buffer\n");
+                MPI_Abort(MPI_COMM_WORLD, 1);
             }
-            
-            sendcounts[i] = local_rows * width;
-            displs[i] = current_row * width;
-            recvcounts[i] = (local_rows / 2) * (width / 2);
-            recvdispls[i] = (current_row / 2) * (width / 2);
-            current_row += local_rows;
         }
+        
+        MPI_Barrier(MPI_COMM_WORLD);
+        double start_time = MPI_Wtime();
+        
+        mpi_resample(input_image, output_image, width, height, new_width, new_height,
+                     channels, opt.filter, rank, size);
+        
+        MPI_Barrier(MPI_COMM_WORLD);
+        double end_time = MPI_Wtime();
+        
+        if(rank == 0) {
+            printf("Elapsed time: %lf seconds\n", end_time - start_time);
+            if(!stbi_write_jpg(argv[2], new_width, new_height, channels, output_image, 100)) {
+                printf("Error: Could not save output image\n");
+            }
+            stbi_image_free(input_image);
+            free(output_image);
+        }
+        
+        MPI_Finalize();
+        return 0;
     }
     
-    // Broadcast local_rows to all processes
-    int local_rows = rows_per_process;
-    if(rank == size - 1 && rank == 0) {
-        local_rows = height;
-        if(local_rows % 2 != 0) local_rows--;
+    // Root owns the row-pair layout (downscale_split.h) and hands each
+    // rank its share with MPI_Scatter
+    Row_Pair_Split split = {0};
+    if(rank == 0 && row_pair_split_init(&split, width, height, channels, size) != 0) {
+        printf("Error: Could not allocate decomposition tables\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
     }
     
+    int local_pairs;
+    MPI_Scatter(split.pair_counts, 1, MPI_INT, &local_pairs, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    int local_rows = 2 * local_pairs;
+    
     
-    uint8_t* local_input = (uint8_t*)malloc(local_rows * width * sizeof(uint8_t));
+    // Exact buffers (+1 so a rank with no rows still gets a valid pointer);
+    // the pipeline receives into its own chunk buffers instead of a slab
+    size_t input_bytes = chunk_rows > 0 ? 0 : (size_t)local_rows * width * channels;
+    uint8_t* local_input = (uint8_t*)malloc(input_bytes + 1);
     int local_new_rows = local_rows / 2;
     int new_width = width / 2;
-    uint8_t* local_output = (uint8_t*)malloc(local_new_rows * new_width * sizeof(uint8_t));
+    uint8_t* local_output = (uint8_t*)malloc((size_t)local_new_rows * new_width * channels + 1);
     
     if(local_input == NULL || local_output == NULL) {
         printf("Process %d: Error allocating memory\n", rank);
         MPI_Abort(MPI_COMM_WORLD, 1);
     }
     
-    // Start timing
-    MPI_Barrier(MPI_COMM_WORLD);
-    double start_time = MPI_Wtime();
-    
-    // Scatter input image to all processes
-    MPI_Scatterv(input_image, sendcounts, displs, MPI_UNSIGNED_CHAR,
-                 local_input, local_rows * width, MPI_UNSIGNED_CHAR,
-                 0, MPI_COMM_WORLD);
-    
-    // Perform local downscaling
-    parallel_downscaling(local_input, local_output, width, local_rows);
-    
-    // Gather output image at root
+    // The pipeline gathers while it computes, so the output buffer has
+    // to exist before the first round
     if(rank == 0) {
         int new_height = height / 2;
-        output_image = (uint8_t*)malloc(new_width * new_height * sizeof(uint8_t));
+        output_image = (uint8_t*)malloc((size_t)new_width * new_height * channels);
         if(output_image == NULL) {
             printf("Error: Could not allocate output buffer\n");
             MPI_Abort(MPI_COMM_WORLD, 1);
         }
+        if(chunk_rows > 0) {
+            int rounds = ((height / 2 + size - 1) / size + chunk_rows - 1) / chunk_rows;
+            printf("Pipeline: %d rounds of up to %d row pairs per rank\n", rounds, chunk_rows);
+        }
     }
     
-    MPI_Gatherv(local_output, local_new_rows * new_width, MPI_UNSIGNED_CHAR,
-                output_image, recvcounts, recvdispls, MPI_UNSIGNED_CHAR,
-                0, MPI_COMM_WORLD);
+    // Start timing
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start_time = MPI_Wtime();
+    double compute_time = 0.0, wait_time = 0.0;
+    
+    if(chunk_rows > 0) {
+        pipelined_downscaling(input_image, output_image, split.pair_counts, local_pairs, local_output,
+                              width, height, channels, chunk_rows, rank, size,
+                              &compute_time, &wait_time);
+    } else {
+        // Scatter input image to all processes
+        MPI_Scatterv(input_image, split.sendcounts, split.displs, MPI_UNSIGNED_CHAR,
+                     local_input, local_rows * width * channels, MPI_UNSIGNED_CHAR,
+                     0, MPI_COMM_WORLD);
+        
+        // Perform local downscaling
+        parallel_downscaling(local_input, local_output, width, local_rows, channels);
+        
+        // Gather output image at root
+        MPI_Gatherv(local_output, local_new_rows * new_width * channels, MPI_UNSIGNED_CHAR,
+                    output_image, split.recvcounts, split.recvdispls, MPI_UNSIGNED_CHAR,
+                    0, MPI_COMM_WORLD);
+    }
     
     // End timing
     MPI_Barrier(MPI_COMM_WORLD);
     double end_time = MPI_Wtime();
     
+    if(chunk_rows > 0) {
+        double busy = compute_time + wait_time;
+        double efficiency = busy > 0.0 ? compute_time / busy : 1.0;
+        double slowest_compute, slowest_wait, worst_efficiency;
+        MPI_Reduce(&compute_time, &slowest_compute, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&wait_time, &slowest_wait, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&efficiency, &worst_efficiency, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+        if(rank == 0) {
+            printf("Downscale time (slowest rank): %lf seconds\n", slowest_compute);
+            printf("Exposed communication (slowest rank): %lf seconds\n", slowest_wait);
+            printf("Overlap efficiency (worst rank): %.1f%%\n", 100.0 * worst_efficiency);
+        }
+    }
+    
     if(rank == 0) {
         printf("Elapsed time: %lf seconds\n", end_time - start_time);
         
         // Save output image
         int new_height = height / 2;
-        int result = stbi_write_jpg(argv[2], new_width, new_height, CHANNEL_NUM, 
+        int result = stbi_write_jpg(argv[2], new_width, new_height, channels, 
                                     output_image, 100);
         
         if(!result) {
@@ -173,10 +623,7 @@ int main(int argc, char* argv[]) {
         // Cleanup
         stbi_image_free(input_image);
         free(output_image);
-        free(sendcounts);
-        free(displs);
-        free(recvcounts);
-        free(recvdispls);
+        row_pair_split_free(&split);
     }
     
     free(local_input);
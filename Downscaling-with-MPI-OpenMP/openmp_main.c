@@ -1,7 +1,14 @@
 /**
  * Parallel Image Downscaling with OpenMP
  * 
- * Usage: ./openmp_main <aybu.jpg> <aybu_openmp.jpg> [num_threads]
+ * Usage: ./openmp_main <aybu.jpg> <aybu_openmp.jpg> [num_threads] [band_rows]
+ *                      [--channels 1|3|4] [--scale <f> | --size <WxH>]
+ *                      [--filter box|bilinear|bicubic|lanczos3]
+ *
+ * Output rows are handed out in contiguous bands sized to stay in L2;
+ * band_rows overrides the auto-tuned band height. Resampling options
+ * replace the 2x2 box kernel with the separable filters in resample.h.
+ * Pixels keep the file's channel layout unless --channels is given.
  */
 
 #include <stdio.h>
@@ -14,30 +21,77 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image.h"
 #include "stb_image_write.h"
+#include "downscale_simd.h"
+#include "downscale_bands.h"
+#include "resample.h"
 
-#define CHANNEL_NUM 1
 
 
-void openmp_downscaling(uint8_t* input_image, uint8_t* output_image, 
-                        int width, int height, int num_threads) {
+void openmp_downscaling(uint8_t* input_image, uint8_t* output_image, int width, int height,
+                        int channels, int num_threads, int band_rows) {
     int new_width = width / 2;
     int new_height = height / 2;
+    int num_bands = (new_height + band_rows - 1) / band_rows;
+    size_t in_stride = (size_t)width * channels;
+    size_t out_stride = (size_t)new_width * channels;
     
     
+    omp_set_num_threads(num_threads);
+    downscale_row_fn downscale_row = downscale_select(channels, NULL);
+    
+    // Parallel OpenMP: each iteration is one contiguous band of output rows
+    #pragma omp parallel for schedule(dynamic, 1)
+    for(int b = 0; b < num_bands; b++) {
+        int row_begin = b * band_rows;
+        int row_end = row_begin + band_rows;
+        if(row_end > new_height) row_end = new_height;
+        
+        for(int i = row_begin; i < row_end; i++) {
+            downscale_row(input_image + (2*i) * in_stride,
+                          input_image + (2*i + 1) * in_stride,
+                          output_image + i * out_stride, new_width);
+        }
+    }
+}
+
+// Arbitrary-ratio downscaling in bands; returns 0, or -1 if out of memory
+int openmp_resample(uint8_t* input_image, uint8_t* output_image, int width, int height,
+                    int new_width, int new_height, int channels, resample_filter filter,
+                    int num_threads, int band_rows) {
+    Resample_Coeffs cx, cy;
+    if(resample_coeffs_init(&cx, width, new_width, filter) != 0) return -1;
+    if(resample_coeffs_init(&cy, height, new_height, filter) != 0) {
+        resample_coeffs_free(&cx);
+        return -1;
+    }
+    
+    int num_bands = (new_height + band_rows - 1) / band_rows;
+    int failed = 0;
+    
     omp_set_num_threads(num_threads);
     
-    // Parallel OpenMP
-    #pragma omp parallel for schedule(dynamic, 8) collapse(2)
-    for(int i = 0; i < new_height; i++) {
-        for(int j = 0; j < new_width; j++) {
-            int sum = 0;
-            sum += input_image[(2*i) * width + (2*j)];
-            sum += input_image[(2*i) * width + (2*j + 1)];
-            sum += input_image[(2*i + 1) * width + (2*j)];
-            sum += input_image[(2*i + 1) * width + (2*j + 1)];
-            output_image[i * new_width + j] = (uint8_t)(sum / 4);
+    #pragma omp parallel reduction(+:failed)
+    {
+        // One float row of vertical-pass scratch per thread
+        float* tmp = (float*)malloc((size_t)width * channels * sizeof(float));
+        if(tmp == NULL) failed++;
+        
+        #pragma omp for schedule(dynamic, 1)
+        for(int b = 0; b < num_bands; b++) {
+            if(tmp == NULL) continue;
+            int row_begin = b * band_rows;
+            int row_end = row_begin + band_rows;
+            if(row_end > new_height) row_end = new_height;
+            
+            resample_rows(input_image, width, channels, 0, &cx, &cy, row_begin, row_end,
+                          output_image + (size_t)row_begin * new_width * channels, tmp);
         }
+        free(tmp);
     }
+    
+    resample_coeffs_free(&cx);
+    resample_coeffs_free(&cy);
+    return failed ? -1 : 0;
 }
 
 double get_time() {
@@ -47,14 +101,18 @@ double get_time() {
 }
 
 int main(int argc, char* argv[]) {
-    if(argc < 3 || argc > 4) {
-        printf("Usage: %s <aybu.jpg> <aybu_openmp.jpg> [num_threads]\n", argv[0]);
+    Resample_Options opt;
+    int channels;
+    if(downscale_parse_channels(&argc, argv, &channels) != 0 ||
+       resample_parse_options(&argc, argv, &opt) != 0 || argc < 3 || argc > 5) {
+        printf("Usage: %s <aybu.jpg> <aybu_openmp.jpg> [num_threads] [band_rows] [--channels 1|3|4] "
+               "[--scale <f> | --size <WxH>] [--filter box|bilinear|bicubic|lanczos3]\n", argv[0]);
         return 1;
     }
     
   
     int num_threads = omp_get_max_threads();
-    if(argc == 4) {
+    if(argc >= 4) {
         num_threads = atoi(argv[3]);
         if(num_threads <= 0) {
             printf("Error: Invalid number of threads\n");
@@ -62,10 +120,21 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    int width, height, bpp;
+    int band_rows = 0;
+    if(argc == 5) {
+        band_rows = atoi(argv[4]);
+        if(band_rows <= 0) {
+            printf("Error: Invalid band height\n");
+            return 1;
+        }
+    }
+    
+    int width, height, bpp = 0;
     
-    // Load 
-    uint8_t* input_image = stbi_load(argv[1], &width, &height, &bpp, CHANNEL_NUM);
+    // Load, interleaved in the file's own layout unless overridden
+    stbi_info(argv[1], &width, &height, &bpp);
+    channels = downscale_load_channels(channels, bpp);
+    uint8_t* input_image = stbi_load(argv[1], &width, &height, &bpp, channels);
     
     if(input_image == NULL) {
         printf("Error: Could not load image %s\n", argv[1]);
@@ -76,17 +145,37 @@ int main(int argc, char* argv[]) {
     printf("Input: %s, Output: %s\n", argv[1], argv[2]);
     printf("Number of threads: %d\n", num_threads);
     printf("Max available threads: %d\n", omp_get_max_threads());
+    printf("Channels: %d\n", channels);
     
+    int new_width = width / 2;
+    int new_height = height / 2;
     
-    if(width % 2 != 0 || height % 2 != 0) {
-        printf("Warning: Image dimensions should be even for 2x downscaling\n");
+    if(opt.enabled) {
+        if(resample_output_size(&opt, width, height, &new_width, &new_height) != 0) {
+            printf("Error: Output size must be between 1x1 and the input size\n");
+            stbi_image_free(input_image);
+            return 1;
+        }
+        printf("Resampling to %dx%d with %s filter\n", new_width, new_height,
+               resample_filter_name(opt.filter));
+    } else {
+        const char* isa;
+        downscale_select(channels, &isa);
+        printf("SIMD kernel: %s\n", isa);
+        
+        if(width % 2 != 0 || height % 2 != 0) {
+            printf("Warning: Image dimensions should be even for 2x downscaling\n");
+        }
     }
     
-    int new_width = width / 2;
-    int new_height = height / 2;
+    long l2_bytes = detect_l2_bytes();
+    if(band_rows == 0) {
+        band_rows = auto_band_rows(width * channels, new_height, num_threads, l2_bytes);
+    }
+    printf("L2 cache: %ld KB, band height: %d output rows\n", l2_bytes / 1024, band_rows);
     
     // Allocate output buffer
-    uint8_t* output_image = (uint8_t*)malloc(new_width * new_height * sizeof(uint8_t));
+    uint8_t* output_image = (uint8_t*)malloc((size_t)new_width * new_height * channels);
     if(output_image == NULL) {
         printf("Error: Could not allocate output buffer\n");
         stbi_image_free(input_image);
@@ -94,15 +183,34 @@ int main(int argc, char* argv[]) {
     }
     
     
+    // Start the thread team up front so the timing covers the downscale only
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    { }
+    
     double time1 = get_time();
     
-    openmp_downscaling(input_image, output_image, width, height, num_threads);
+    int status = 0;
+    if(opt.enabled) {
+        status = openmp_resample(input_image, output_image, width, height, new_width, new_height,
+                                 channels, opt.filter, num_threads, band_rows);
+    } else {
+        openmp_downscaling(input_image, output_image, width, height, channels,
+                           num_threads, band_rows);
+    }
     
     double time2 = get_time();
     printf("Elapsed time: %lf seconds\n", time2 - time1);
     
+    if(status != 0) {
+        printf("Error: Could not allocate resampling buffers\n");
+        stbi_image_free(input_image);
+        free(output_image);
+        return 1;
+    }
+    
     // Save 
-    int result = stbi_write_jpg(argv[2], new_width, new_height, CHANNEL_NUM, 
+    int result = stbi_write_jpg(argv[2], new_width, new_height, channels, 
                                 output_image, 100);
     
     if(!result) {
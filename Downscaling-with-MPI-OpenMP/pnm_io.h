@@ -0,0 +1,65 @@
+/**
+ * Raw PGM / PPM Helpers
+ *
+ * Binary PGM (P5, grey) and PPM (P6, RGB) files are a short text header
+ * followed by the pixels, row-major and interleaved. Programs that read
+ * or write them in slabs (streaming, MPI-IO) only need the header
+ * length and the image size to compute any row's byte offset.
+ */
+
+#ifndef PNM_IO_H
+#define PNM_IO_H
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+// Skip whitespace and '#' comments between header fields
+static inline int pnm_skip_space(FILE* fp) {
+    int c = fgetc(fp);
+    while(c != EOF) {
+        if(c == '#') {
+            while(c != EOF && c != '\n') c = fgetc(fp);
+        } else if(!isspace(c)) {
+            return ungetc(c, fp) == EOF ? -1 : 0;
+        }
+        c = fgetc(fp);
+    }
+    return -1;
+}
+
+// Read an 8-bit P5 / P6 header, leaving fp at the first pixel
+static inline int pnm_read_header(FILE* fp, int* width, int* height, int* maxval,
+                                  int* channels) {
+    char magic[3] = {0};
+    if(fread(magic, 1, 2, fp) != 2 || magic[0] != 'P') return -1;
+    if(magic[1] == '5') *channels = 1;
+    else if(magic[1] == '6') *channels = 3;
+    else return -1;
+
+    if(pnm_skip_space(fp) != 0 || fscanf(fp, "%d", width) != 1) return -1;
+    if(pnm_skip_space(fp) != 0 || fscanf(fp, "%d", height) != 1) return -1;
+    if(pnm_skip_space(fp) != 0 || fscanf(fp, "%d", maxval) != 1) return -1;
+
+    // Exactly one whitespace byte separates the header from the pixels
+    if(!isspace(fgetc(fp))) return -1;
+    if(*width <= 0 || *height <= 0 || *maxval <= 0 || *maxval > 255) return -1;
+    return 0;
+}
+
+// Header for a width x height image; returns its length in bytes
+static inline int pnm_format_header(char* buf, size_t size, int width, int height,
+                                    int maxval, int channels) {
+    return snprintf(buf, size, "P%c\n%d %d\n%d\n", channels == 3 ? '6' : '5',
+                    width, height, maxval);
+}
+
+// True for a .pgm, .ppm or .pnm file name
+static inline int pnm_is_path(const char* path) {
+    size_t n = strlen(path);
+    if(n < 4) return 0;
+    const char* ext = path + n - 4;
+    return strcmp(ext, ".pgm") == 0 || strcmp(ext, ".ppm") == 0 || strcmp(ext, ".pnm") == 0;
+}
+
+#endif // PNM_IO_H
@@ -0,0 +1,222 @@
+/**
+ * Image Pyramid (Mipmap) Generation with OpenMP
+ *
+ * Usage: ./pyramid_main <aybu.jpg> <output_prefix> [levels] [num_threads]
+ *                         [--channels 1|3|4]
+ *
+ * Decodes the input once and writes <output_prefix>_level<k>.jpg for
+ * k = 1..levels (1/2, 1/4, 1/8, ... of the input). Without [levels]
+ * the pyramid goes down to a single row or column.
+ *
+ * The first PYRAMID_BLOCK_LEVELS levels are cache-blocked: the input is
+ * cut into L2-sized tiles and each tile is pushed through all of those
+ * levels before the next tile is touched. The remaining levels are tiny
+ * and are computed level by level. All levels are then encoded in
+ * parallel, one file per thread. Pixels keep the file's channel layout
+ * unless --channels is given.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <sys/time.h>
+#include <omp.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "downscale_simd.h"
+#include "downscale_bands.h"
+
+#define PYRAMID_MAX_LEVELS 30
+#define PYRAMID_BLOCK_LEVELS 6
+
+
+// Square level-0 tile (multiple of 2^blocked) whose pyramid fits in half of L2
+int pyramid_tile_side(int blocked_levels, int channels, long l2_bytes) {
+    int unit = 1 << blocked_levels;
+    // A tile plus all of its coarser levels is 4/3 of the tile itself
+    int side = (int)sqrt((double)(l2_bytes / 2) / channels * 3.0 / 4.0);
+    side -= side % unit;
+    return side < unit ? unit : side;
+}
+
+void pyramid_downscaling(uint8_t** level, const int* widths, const int* heights,
+                         int levels, int channels, int tile_side, int num_threads) {
+    int blocked = levels < PYRAMID_BLOCK_LEVELS ? levels : PYRAMID_BLOCK_LEVELS;
+    int tiles_x = (widths[0] + tile_side - 1) / tile_side;
+    int tiles_y = (heights[0] + tile_side - 1) / tile_side;
+
+    omp_set_num_threads(num_threads);
+    downscale_row_fn downscale_row = downscale_select(channels, NULL);
+
+    // Blocked levels: a tile at level l covers tile_side >> l rows and
+    // columns, and needs only its own rows and columns at level l - 1
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for(int ty = 0; ty < tiles_y; ty++) {
+        for(int tx = 0; tx < tiles_x; tx++) {
+            for(int l = 1; l <= blocked; l++) {
+                int side = tile_side >> l;
+                int row_begin = ty * side;
+                int row_end = row_begin + side;
+                int col_begin = tx * side;
+                int cols = side;
+                if(row_end > heights[l]) row_end = heights[l];
+                if(col_begin + cols > widths[l]) cols = widths[l] - col_begin;
+                if(cols <= 0) break;
+
+                // Column offsets are in pixels; rows are interleaved bytes
+                const uint8_t* src = level[l - 1];
+                uint8_t* dst = level[l];
+                size_t src_stride = (size_t)widths[l - 1] * channels;
+                size_t dst_stride = (size_t)widths[l] * channels;
+                size_t src_col = (size_t)2 * col_begin * channels;
+                size_t dst_col = (size_t)col_begin * channels;
+                for(int i = row_begin; i < row_end; i++) {
+                    downscale_row(src + (2*i) * src_stride + src_col,
+                                  src + (2*i + 1) * src_stride + src_col,
+                                  dst + i * dst_stride + dst_col, cols);
+                }
+            }
+        }
+    }
+
+    // Remaining levels are at most 1/4096 of the input; go level by level
+    for(int l = blocked + 1; l <= levels; l++) {
+        #pragma omp parallel for schedule(static)
+        for(int i = 0; i < heights[l]; i++) {
+            size_t src_stride = (size_t)widths[l - 1] * channels;
+            downscale_row(level[l - 1] + (2*i) * src_stride,
+                          level[l - 1] + (2*i + 1) * src_stride,
+                          level[l] + (size_t)i * widths[l] * channels, widths[l]);
+        }
+    }
+}
+
+double get_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+int main(int argc, char* argv[]) {
+    int channels;
+    if(downscale_parse_channels(&argc, argv, &channels) != 0 || argc < 3 || argc > 5) {
+        printf("Usage: %s <aybu.jpg> <output_prefix> [levels] [num_threads] [--channels 1|3|4]\n",
+               argv[0]);
+        return 1;
+    }
+
+    int levels = 0;
+    if(argc >= 4) {
+        levels = atoi(argv[3]);
+        if(levels <= 0 || levels > PYRAMID_MAX_LEVELS) {
+            printf("Error: Invalid number of levels (1-%d)\n", PYRAMID_MAX_LEVELS);
+            return 1;
+        }
+    }
+
+    int num_threads = omp_get_max_threads();
+    if(argc == 5) {
+        num_threads = atoi(argv[4]);
+        if(num_threads <= 0) {
+            printf("Error: Invalid number of threads\n");
+            return 1;
+        }
+    }
+
+    int width, height, bpp = 0;
+
+    // Load (the only decode), interleaved in the file's own layout unless overridden
+    stbi_info(argv[1], &width, &height, &bpp);
+    channels = downscale_load_channels(channels, bpp);
+    uint8_t* input_image = stbi_load(argv[1], &width, &height, &bpp, channels);
+
+    if(input_image == NULL) {
+        printf("Error: Could not load image %s\n", argv[1]);
+        return 1;
+    }
+
+    // Level sizes: each level halves the previous one, rounding down
+    int widths[PYRAMID_MAX_LEVELS + 1];
+    int heights[PYRAMID_MAX_LEVELS + 1];
+    widths[0] = width;
+    heights[0] = height;
+    int max_levels = 0;
+    while(max_levels < PYRAMID_MAX_LEVELS &&
+          widths[max_levels] / 2 > 0 && heights[max_levels] / 2 > 0) {
+        widths[max_levels + 1] = widths[max_levels] / 2;
+        heights[max_levels + 1] = heights[max_levels] / 2;
+        max_levels++;
+    }
+    if(levels == 0) levels = max_levels;
+    if(levels > max_levels) {
+        printf("Error: %dx%d image supports at most %d levels\n", width, height, max_levels);
+        stbi_image_free(input_image);
+        return 1;
+    }
+
+    int blocked = levels < PYRAMID_BLOCK_LEVELS ? levels : PYRAMID_BLOCK_LEVELS;
+    long l2_bytes = detect_l2_bytes();
+    int tile_side = pyramid_tile_side(blocked, channels, l2_bytes);
+
+    printf("Width: %d  Height: %d\n", width, height);
+    printf("Input: %s, Output: %s_level<1..%d>.jpg\n", argv[1], argv[2], levels);
+    printf("Number of threads: %d\n", num_threads);
+    printf("Channels: %d\n", channels);
+
+    const char* isa;
+    downscale_select(channels, &isa);
+    printf("SIMD kernel: %s\n", isa);
+    printf("L2 cache: %ld KB, tile: %dx%d pixels, %d blocked levels\n",
+           l2_bytes / 1024, tile_side, tile_side, blocked);
+
+    // Allocate all levels up front (together about 1/3 of the input)
+    uint8_t* level[PYRAMID_MAX_LEVELS + 1];
+    level[0] = input_image;
+    int ok = 1;
+    for(int l = 1; l <= levels; l++) {
+        level[l] = (uint8_t*)malloc((size_t)widths[l] * heights[l] * channels);
+        if(level[l] == NULL) ok = 0;
+    }
+    if(!ok) {
+        printf("Error: Could not allocate pyramid buffers\n");
+        for(int l = 1; l <= levels; l++) free(level[l]);
+        stbi_image_free(input_image);
+        return 1;
+    }
+
+    // Start the thread team up front so the timing covers the downscale only
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    { }
+
+    double time1 = get_time();
+
+    pyramid_downscaling(level, widths, heights, levels, channels, tile_side, num_threads);
+
+    double time2 = get_time();
+    printf("Elapsed time: %lf seconds\n", time2 - time1);
+
+    // Save every level to its own file, one level per thread
+    int failed = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:failed)
+    for(int l = 1; l <= levels; l++) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s_level%d.jpg", argv[2], l);
+        if(!stbi_write_jpg(path, widths[l], heights[l], channels, level[l], 100)) {
+            printf("Error: Could not save output image %s\n", path);
+            failed++;
+        }
+    }
+
+    double time3 = get_time();
+    printf("Encode time (%d levels): %lf seconds\n", levels, time3 - time2);
+
+    for(int l = 1; l <= levels; l++) free(level[l]);
+    stbi_image_free(input_image);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * Separable Arbitrary-Ratio Resampling
+ *
+ * Shared by seq_main, openmp_main and mpi_main for any output size
+ * (e.g. 1920 -> 1280, or 3x), with four filters:
+ *
+ *   box      support 0.5   area average
+ *   bilinear support 1     triangle
+ *   bicubic  support 2     Keys cubic, a = -0.5
+ *   lanczos3 support 3     sinc(x) * sinc(x/3)
+ *
+ * When downscaling, the filter is stretched by the scale factor so every
+ * input pixel contributes. Both axes use a precomputed coefficient table
+ * (window start plus a fixed number of zero-padded weights per output
+ * pixel). One output row is produced by a vertical pass into a float
+ * row and then a horizontal pass, so callers only need one float row of
+ * scratch per thread and can split output rows across threads or ranks.
+ *
+ * Pixels are interleaved with `channels` bytes each.
+ */
+
+#ifndef RESAMPLE_H
+#define RESAMPLE_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    RESAMPLE_BOX,
+    RESAMPLE_BILINEAR,
+    RESAMPLE_BICUBIC,
+    RESAMPLE_LANCZOS3
+} resample_filter;
+
+typedef struct {
+    int in_size;
+    int out_size;
+    int taps;           // weights per output pixel (window, zero padded)
+    int* start;         // first input index of each window
+    float* weights;     // out_size * taps, each window sums to 1
+} Resample_Coeffs;
+
+typedef struct {
+    int enabled;        // any resampling option given
+    double scale;       // input / output size, used when no explicit size
+    int out_width;
+    int out_height;
+    resample_filter filter;
+} Resample_Options;
+
+#define RESAMPLE_PI 3.14159265358979323846
+
+static inline const char* resample_filter_name(resample_filter f) {
+    switch(f) {
+        case RESAMPLE_BOX:      return "box";
+        case RESAMPLE_BILINEAR: return "bilinear";
+        case RESAMPLE_BICUBIC:  return "bicubic";
+        default:                return "lanczos3";
+    }
+}
+
+static inline double resample_support(resample_filter f) {
+    switch(f) {
+        case RESAMPLE_BOX:      return 0.5;
+        case RESAMPLE_BILINEAR: return 1.0;
+        case RESAMPLE_BICUBIC:  return 2.0;
+        default:                return 3.0;
+    }
+}
+
+static inline double resample_sinc(double x) {
+    if(x == 0.0) return 1.0;
+    x *= RESAMPLE_PI;
+    return sin(x) / x;
+}
+
+static inline double resample_kernel(resample_filter f, double x) {
+    double ax = fabs(x);
+    switch(f) {
+        case RESAMPLE_BOX:
+            return (x >= -0.5 && x < 0.5) ? 1.0 : 0.0;
+        case RESAMPLE_BILINEAR:
+            return ax < 1.0 ? 1.0 - ax : 0.0;
+        case RESAMPLE_BICUBIC: {
+            const double a = -0.5;
+            if(ax < 1.0) return ((a + 2.0) * ax - (a + 3.0)) * ax * ax + 1.0;
+            if(ax < 2.0) return (((ax - 5.0) * ax + 8.0) * ax - 4.0) * a;
+            return 0.0;
+        }
+        default:
+            return ax < 3.0 ? resample_sinc(x) * resample_sinc(x / 3.0) : 0.0;
+    }
+}
+
+// Build the coefficient table for one axis; returns 0 on success
+static inline int resample_coeffs_init(Resample_Coeffs* c, int in_size, int out_size,
+                                resample_filter f) {
+    double scale = (double)in_size / out_size;
+    double filter_scale = scale > 1.0 ? scale : 1.0;
+    double support = resample_support(f) * filter_scale;
+
+    int taps = (int)ceil(support) * 2 + 1;
+    if(taps > in_size) taps = in_size;
+
+    c->in_size = in_size;
+    c->out_size = out_size;
+    c->taps = taps;
+    c->start = (int*)malloc((size_t)out_size * sizeof(int));
+    c->weights = (float*)calloc((size_t)out_size * taps, sizeof(float));
+    if(c->start == NULL || c->weights == NULL) {
+        free(c->start);
+        free(c->weights);
+        return -1;
+    }
+
+    double* w = (double*)malloc((size_t)taps * sizeof(double));
+    if(w == NULL) {
+        free(c->start);
+        free(c->weights);
+        return -1;
+    }
+
+    for(int j = 0; j < out_size; j++) {
+        double center = (j + 0.5) * scale;
+        int xmin = (int)(center - support + 0.5);
+        int xmax = (int)(center + support + 0.5);
+        if(xmin < 0) xmin = 0;
+        if(xmax > in_size) xmax = in_size;
+        if(xmax - xmin > taps) xmax = xmin + taps;
+
+        double total = 0.0;
+        for(int k = 0; k < xmax - xmin; k++) {
+            w[k] = resample_kernel(f, (xmin + k - center + 0.5) / filter_scale);
+            total += w[k];
+        }
+
+        // Keep the padded window inside the image; weights shift with it
+        int start = xmin;
+        if(start + taps > in_size) start = in_size - taps;
+        c->start[j] = start;
+
+        float* row = c->weights + (size_t)j * taps;
+        for(int k = 0; k < xmax - xmin; k++) {
+            row[xmin - start + k] = (float)(total != 0.0 ? w[k] / total : 0.0);
+        }
+    }
+
+    free(w);
+    return 0;
+}
+
+static inline void resample_coeffs_free(Resample_Coeffs* c) {
+    free(c->start);
+    free(c->weights);
+    c->start = NULL;
+    c->weights = NULL;
+}
+
+// Output rows [row_begin, row_end); row_begin lands at the start of out.
+// `in` holds input rows from in_row_offset on; tmp holds in_width * channels floats.
+static inline void resample_rows(const uint8_t* in, int in_width, int channels, int in_row_offset,
+                          const Resample_Coeffs* cx, const Resample_Coeffs* cy,
+                          int row_begin, int row_end, uint8_t* out, float* tmp) {
+    size_t in_stride = (size_t)in_width * channels;
+    size_t out_stride = (size_t)cx->out_size * channels;
+    int n = (int)in_stride;
+
+    for(int i = row_begin; i < row_end; i++) {
+        // Vertical pass: weighted sum of the window's input rows
+        const float* wy = cy->weights + (size_t)i * cy->taps;
+        const uint8_t* src = in + (size_t)(cy->start[i] - in_row_offset) * in_stride;
+        memset(tmp, 0, (size_t)n * sizeof(float));
+        for(int k = 0; k < cy->taps; k++) {
+            float w = wy[k];
+            if(w == 0.0f) continue;
+            const uint8_t* s = src + (size_t)k * in_stride;
+            #pragma omp simd
+            for(int x = 0; x < n; x++) {
+                tmp[x] += w * (float)s[x];
+            }
+        }
+
+        // Horizontal pass: fixed-length windows over the float row
+        uint8_t* dst = out + (size_t)(i - row_begin) * out_stride;
+        for(int j = 0; j < cx->out_size; j++) {
+            const float* wx = cx->weights + (size_t)j * cx->taps;
+            const float* t = tmp + (size_t)cx->start[j] * channels;
+            for(int ch = 0; ch < channels; ch++) {
+                float acc = 0.0f;
+                #pragma omp simd reduction(+:acc)
+                for(int k = 0; k < cx->taps; k++) {
+                    acc += wx[k] * t[(size_t)k * channels + ch];
+                }
+                int v = (int)(acc + 0.5f);
+                dst[(size_t)j * channels + ch] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+            }
+        }
+    }
+}
+
+// Input rows [*first, *last) needed for output rows [row_begin, row_end)
+static inline void resample_input_rows(const Resample_Coeffs* cy, int row_begin, int row_end,
+                                int* first, int* last) {
+    *first = 0;
+    *last = 0;
+    if(row_begin >= row_end) return;
+    // Window starts never decrease, so the ends bound the range
+    *first = cy->start[row_begin];
+    *last = cy->start[row_end - 1] + cy->taps;
+}
+
+static inline int resample_parse_filter(const char* name, resample_filter* f) {
+    if(strcmp(name, "box") == 0 || strcmp(name, "area") == 0) *f = RESAMPLE_BOX;
+    else if(strcmp(name, "bilinear") == 0) *f = RESAMPLE_BILINEAR;
+    else if(strcmp(name, "bicubic") == 0) *f = RESAMPLE_BICUBIC;
+    else if(strcmp(name, "lanczos3") == 0 || strcmp(name, "lanczos") == 0) *f = RESAMPLE_LANCZOS3;
+    else return -1;
+    return 0;
+}
+
+// Take --scale <f>, --size <WxH> and --filter <name> out of argv, leaving
+// the positional arguments in place. Returns 0, or -1 on a bad option.
+static inline int resample_parse_options(int* argc, char** argv, Resample_Options* opt) {
+    opt->enabled = 0;
+    opt->scale = 2.0;
+    opt->out_width = 0;
+    opt->out_height = 0;
+    opt->filter = RESAMPLE_BOX;
+
+    int kept = 1;
+    for(int a = 1; a < *argc; a++) {
+        const char* arg = argv[a];
+        int is_opt = strcmp(arg, "--scale") == 0 || strcmp(arg, "--size") == 0 ||
+                     strcmp(arg, "--filter") == 0;
+        if(!is_opt) {
+            argv[kept++] = argv[a];
+            continue;
+        }
+        if(a + 1 >= *argc) return -1;
+        const char* val = argv[++a];
+        opt->enabled = 1;
+
+        if(strcmp(arg, "--scale") == 0) {
+            opt->scale = atof(val);
+            if(!(opt->scale >= 1.0)) return -1;
+        } else if(strcmp(arg, "--size") == 0) {
+            if(sscanf(val, "%dx%d", &opt->out_width, &opt->out_height) != 2 ||
+               opt->out_width <= 0 || opt->out_height <= 0) return -1;
+        } else if(resample_parse_filter(val, &opt->filter) != 0) {
+            return -1;
+        }
+    }
+    *argc = kept;
+    argv[kept] = NULL;
+    return 0;
+}
+
+// Output size for a width x height input; returns -1 if it is not a downscale
+static inline int resample_output_size(const Resample_Options* opt, int width, int height,
+                                int* new_width, int* new_height) {
+    if(opt->out_width > 0) {
+        *new_width = opt->out_width;
+        *new_height = opt->out_height;
+    } else {
+        *new_width = (int)(width / opt->scale);
+        *new_height = (int)(height / opt->scale);
+    }
+    if(*new_width < 1 || *new_height < 1 || *new_width > width || *new_height > height) {
+        return -1;
+    }
+    return 0;
+}
+
+#endif // RESAMPLE_H
@@ -1,7 +1,12 @@
 /**jpg
  * Sequential Image Downscaling
  * 
- * Usage: ./seq_main <aybu.jpg> <aybu_seq.jpg>
+ * Usage: ./seq_main <aybu.jpg> <aybu_seq.jpg> [--channels 1|3|4]
+ *                   [--scale <f> | --size <WxH>] [--filter box|bilinear|bicubic|lanczos3]
+ *
+ * Without options the image is halved with the 2x2 box kernel; any
+ * scale option switches to the separable resampler in resample.h.
+ * Pixels keep the file's channel layout unless --channels is given.
  */
 
 #include <stdio.h>
@@ -13,26 +18,47 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image.h"
 #include "stb_image_write.h"
+#include "downscale_simd.h"
+#include "resample.h"
 
-#define CHANNEL_NUM 1
 
 
 void seq_downscaling(uint8_t* input_image, uint8_t* output_image, 
-                     int width, int height) {
+                     int width, int height, int channels) {
     int new_width = width / 2;
     int new_height = height / 2;
+    size_t in_stride = (size_t)width * channels;
+    size_t out_stride = (size_t)new_width * channels;
+    downscale_row_fn downscale_row = downscale_select(channels, NULL);
     
+    // Average 2x2 blocks, one row pair at a time
     for(int i = 0; i < new_height; i++) {
-        for(int j = 0; j < new_width; j++) {
-            // Average 2x2 block of pixels
-            int sum = 0;
-            sum += input_image[(2*i) * width + (2*j)];
-            sum += input_image[(2*i) * width + (2*j + 1)];
-            sum += input_image[(2*i + 1) * width + (2*j)];
-            sum += input_image[(2*i + 1) * width + (2*j + 1)];
-            output_image[i * new_width + j] = (uint8_t)(sum / 4);
-        }
+        downscale_row(input_image + (2*i) * in_stride,
+                      input_image + (2*i + 1) * in_stride,
+                      output_image + i * out_stride, new_width);
+    }
+}
+
+// Arbitrary-ratio downscaling; returns 0, or -1 if out of memory
+int seq_resample(uint8_t* input_image, uint8_t* output_image, int width, int height,
+                 int new_width, int new_height, int channels, resample_filter filter) {
+    Resample_Coeffs cx, cy;
+    if(resample_coeffs_init(&cx, width, new_width, filter) != 0) return -1;
+    if(resample_coeffs_init(&cy, height, new_height, filter) != 0) {
+        resample_coeffs_free(&cx);
+        return -1;
+    }
+    
+    float* tmp = (float*)malloc((size_t)width * channels * sizeof(float));
+    if(tmp != NULL) {
+        resample_rows(input_image, width, channels, 0, &cx, &cy,
+                      0, new_height, output_image, tmp);
     }
+    
+    free(tmp);
+    resample_coeffs_free(&cx);
+    resample_coeffs_free(&cy);
+    return tmp != NULL ? 0 : -1;
 }
 
 double get_time() {
@@ -42,15 +68,21 @@ double get_time() {
 }
 
 int main(int argc, char* argv[]) {
-    if(argc != 3) {
-        printf("Usage: %s <aybu.jpg> <aybu_seq.jpg>\n", argv[0]);
+    Resample_Options opt;
+    int channels;
+    if(downscale_parse_channels(&argc, argv, &channels) != 0 ||
+       resample_parse_options(&argc, argv, &opt) != 0 || argc != 3) {
+        printf("Usage: %s <aybu.jpg> <aybu_seq.jpg> [--channels 1|3|4] [--scale <f> | --size <WxH>] "
+               "[--filter box|bilinear|bicubic|lanczos3]\n", argv[0]);
         return 1;
     }
     
-    int width, height, bpp;
+    int width, height, bpp = 0;
     
-    // Load image 
-    uint8_t* input_image = stbi_load(argv[1], &width, &height, &bpp, CHANNEL_NUM);
+    // Load image, interleaved in the file's own layout unless overridden
+    stbi_info(argv[1], &width, &height, &bpp);
+    channels = downscale_load_channels(channels, bpp);
+    uint8_t* input_image = stbi_load(argv[1], &width, &height, &bpp, channels);
     
     if(input_image == NULL) {
         printf("Error: Could not load image %s\n", argv[1]);
@@ -59,17 +91,31 @@ int main(int argc, char* argv[]) {
     
     printf("Width: %d  Height: %d\n", width, height);
     printf("Input: %s, Output: %s\n", argv[1], argv[2]);
-    
-    
-    if(width % 2 != 0 || height % 2 != 0) {
-        printf("Warning: Image dimensions should be even for 2x downscaling\n");
-    }
+    printf("Channels: %d\n", channels);
     
     int new_width = width / 2;
     int new_height = height / 2;
     
+    if(opt.enabled) {
+        if(resample_output_size(&opt, width, height, &new_width, &new_height) != 0) {
+            printf("Error: Output size must be between 1x1 and the input size\n");
+            stbi_image_free(input_image);
+            return 1;
+        }
+        printf("Resampling to %dx%d with %s filter\n", new_width, new_height,
+               resample_filter_name(opt.filter));
+    } else {
+        const char* isa;
+        downscale_select(channels, &isa);
+        printf("SIMD kernel: %s\n", isa);
+        
+        if(width % 2 != 0 || height % 2 != 0) {
+            printf("Warning: Image dimensions should be even for 2x downscaling\n");
+        }
+    }
+    
     // Allocate output buffer
-    uint8_t* output_image = (uint8_t*)malloc(new_width * new_height * sizeof(uint8_t));
+    uint8_t* output_image = (uint8_t*)malloc((size_t)new_width * new_height * channels);
     if(output_image == NULL) {
         printf("Error: Could not allocate output buffer\n");
         stbi_image_free(input_image);
@@ -79,13 +125,26 @@ int main(int argc, char* argv[]) {
     // Time the downscaling operation
     double time1 = get_time();
     
-    seq_downscaling(input_image, output_image, width, height);
+    int status = 0;
+    if(opt.enabled) {
+        status = seq_resample(input_image, output_image, width, height,
+                              new_width, new_height, channels, opt.filter);
+    } else {
+        seq_downscaling(input_image, output_image, width, height, channels);
+    }
     
     double time2 = get_time();
     printf("Elapsed time: %lf seconds\n", time2 - time1);
     
+    if(status != 0) {
+        printf("Error: Could not allocate resampling buffers\n");
+        stbi_image_free(input_image);
+        free(output_image);
+        return 1;
+    }
+    
     // Save output image
-    int result = stbi_write_jpg(argv[2], new_width, new_height, CHANNEL_NUM, 
+    int result = stbi_write_jpg(argv[2], new_width, new_height, channels, 
                                 output_image, 100);
     
     if(!result) {
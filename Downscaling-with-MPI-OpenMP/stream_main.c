@@ -0,0 +1,188 @@
+/**
+ * Streaming Band-Pipelined Image Downscaling (PGM)
+ *
+ * Usage: ./stream_main <input.pgm> <output.pgm> [num_threads] [band_rows]
+ *
+ * The image is never decoded as a whole. Bands of input rows are read
+ * from the file, downscaled on worker threads and written out scanline
+ * by scanline. Up to STREAM_SLOTS bands are in flight, so reading band
+ * k+1, downscaling band k and writing band k-1 overlap. Peak memory is
+ * STREAM_SLOTS band buffers, whatever the image size.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <omp.h>
+
+#include "downscale_simd.h"
+#include "downscale_bands.h"
+#include "pnm_io.h"
+
+#define STREAM_SLOTS 3
+
+
+int stream_downscaling(FILE* in, FILE* out, int width, int height,
+                       int num_threads, int band_rows, int tile_rows) {
+    int new_width = width / 2;
+    int new_height = height / 2;
+    int num_bands = (new_height + band_rows - 1) / band_rows;
+    downscale_row_fn downscale_row = downscale_select(1, NULL);
+
+    uint8_t* in_buf[STREAM_SLOTS];
+    uint8_t* out_buf[STREAM_SLOTS];
+    int ok = 1;
+    for(int s = 0; s < STREAM_SLOTS; s++) {
+        in_buf[s] = (uint8_t*)malloc((size_t)2 * band_rows * width);
+        out_buf[s] = (uint8_t*)malloc((size_t)band_rows * new_width);
+        if(in_buf[s] == NULL || out_buf[s] == NULL) ok = 0;
+    }
+
+    int status = ok ? 0 : -1;
+
+    omp_set_num_threads(num_threads);
+
+    // Dependences: the FILE handles serialise reads and writes, the slot
+    // buffers order read -> downscale -> write for each band
+    #pragma omp parallel if(ok)
+    #pragma omp single
+    for(int b = 0; b < num_bands && ok; b++) {
+        int s = b % STREAM_SLOTS;
+        int rows = new_height - b * band_rows;
+        if(rows > band_rows) rows = band_rows;
+
+        #pragma omp task depend(inout: in) depend(out: in_buf[s][0]) firstprivate(s, rows)
+        {
+            size_t bytes = (size_t)2 * rows * width;
+            if(fread(in_buf[s], 1, bytes, in) != bytes) {
+                #pragma omp atomic write
+                status = -1;
+            }
+        }
+
+        #pragma omp task depend(in: in_buf[s][0]) depend(out: out_buf[s][0]) firstprivate(s, rows)
+        {
+            #pragma omp taskloop grainsize(tile_rows)
+            for(int i = 0; i < rows; i++) {
+                downscale_row(in_buf[s] + (size_t)(2*i) * width,
+                              in_buf[s] + (size_t)(2*i + 1) * width,
+                              out_buf[s] + (size_t)i * new_width, new_width);
+            }
+        }
+
+        #pragma omp task depend(inout: out) depend(in: out_buf[s][0]) firstprivate(s, rows)
+        {
+            size_t bytes = (size_t)rows * new_width;
+            if(fwrite(out_buf[s], 1, bytes, out) != bytes) {
+                #pragma omp atomic write
+                status = -1;
+            }
+        }
+    }
+
+    for(int s = 0; s < STREAM_SLOTS; s++) {
+        free(in_buf[s]);
+        free(out_buf[s]);
+    }
+    return status;
+}
+
+double get_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 3 || argc > 5) {
+        printf("Usage: %s <input.pgm> <output.pgm> [num_threads] [band_rows]\n", argv[0]);
+        return 1;
+    }
+
+    int num_threads = omp_get_max_threads();
+    if(argc >= 4) {
+        num_threads = atoi(argv[3]);
+        if(num_threads <= 0) {
+            printf("Error: Invalid number of threads\n");
+            return 1;
+        }
+    }
+
+    int band_rows = 0;
+    if(argc == 5) {
+        band_rows = atoi(argv[4]);
+        if(band_rows <= 0) {
+            printf("Error: Invalid band height\n");
+            return 1;
+        }
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if(in == NULL) {
+        printf("Error: Could not open image %s\n", argv[1]);
+        return 1;
+    }
+
+    int width, height, maxval, channels;
+    if(pnm_read_header(in, &width, &height, &maxval, &channels) != 0 || channels != 1) {
+        printf("Error: %s is not an 8-bit binary PGM (P5)\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+
+    printf("Width: %d  Height: %d\n", width, height);
+    printf("Input: %s, Output: %s\n", argv[1], argv[2]);
+    printf("Number of threads: %d\n", num_threads);
+
+    const char* isa;
+    downscale_select(1, &isa);
+    printf("SIMD kernel: %s\n", isa);
+
+    if(width % 2 != 0 || height % 2 != 0) {
+        printf("Warning: Image dimensions should be even for 2x downscaling\n");
+    }
+
+    int new_width = width / 2;
+    int new_height = height / 2;
+    if(new_width == 0 || new_height == 0) {
+        printf("Error: Image is too small to downscale\n");
+        fclose(in);
+        return 1;
+    }
+
+    // Each worker downscales an L2-sized tile; a band feeds every worker once
+    int tile_rows = l2_band_rows(width, detect_l2_bytes());
+    if(band_rows == 0) {
+        band_rows = tile_rows * num_threads;
+    }
+    if(band_rows > new_height) band_rows = new_height;
+
+    size_t buffer_bytes = (size_t)STREAM_SLOTS * band_rows * (2 * (size_t)width + new_width);
+    printf("Band height: %d output rows, %d bands in flight, buffers: %.2f MB\n",
+           band_rows, STREAM_SLOTS, buffer_bytes / (1024.0 * 1024.0));
+
+    FILE* out = fopen(argv[2], "wb");
+    if(out == NULL) {
+        printf("Error: Could not open output %s\n", argv[2]);
+        fclose(in);
+        return 1;
+    }
+    fprintf(out, "P5\n%d %d\n%d\n", new_width, new_height, maxval);
+
+    double time1 = get_time();
+
+    int result = stream_downscaling(in, out, width, height, num_threads, band_rows, tile_rows);
+
+    double time2 = get_time();
+    printf("Elapsed time: %lf seconds\n", time2 - time1);
+
+    if(result != 0) {
+        printf("Error: Streaming downscale failed (short read, write error or out of memory)\n");
+    }
+
+    fclose(in);
+    if(fclose(out) != 0) result = -1;
+
+    return result == 0 ? 0 : 1;
+}
@@ -41,4 +41,13 @@
  */
 void spmv_bcsr_bucket_parallel(const BCSR_Matrix *A, const double *x, double *y);
 
+/**
+ * BCSR+Bucket Parallel y = α·A·x + β·y
+ * 
+ * Block-row sums are accumulated in registers and combined with y
+ * in a single store per row.
+ */
+void spmv_bcsr_bucket_parallel_mv(double alpha, const BCSR_Matrix *A, const double *x,
+                                  double beta, double *y);
+
 #endif // BCSR_BUCKET_PARALLEL_H
@@ -5,41 +5,54 @@
 #include "bcsr_parallel.h"
 #include <omp.h>
 
+// One instantiation per α/β mode (see MV_MODE_LIST).
+// A block row owns its 4 rows, so sums stay in registers and y is
+// written once per row (no memset pass).
+#define DEFINE_BCSR_PARALLEL_MV(MODE, STORE)                                \
+static void bcsr_parallel_mv_##MODE(double alpha, const BCSR_Matrix *A,     \
+                                    const double *x, double beta, double *y) { \
+    (void)alpha; (void)beta;                                                \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int br = 0; br < A->block_rows; br++) {                            \
+        int row_start = br * 4;                                             \
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;                      \
+                                                                            \
+        for (int kb = A->block_row_ptr[br]; kb < A->block_row_ptr[br + 1]; kb++) { \
+            int bc = A->block_col_idx[kb];                                  \
+            int col_start = bc * 4;                                         \
+            const double *block = &A->block_val[(size_t)kb * 16];           \
+                                                                            \
+            /* Register blocking: load 4 x values once */                   \
+            double x0 = (col_start + 0 < A->cols) ? x[col_start + 0] : 0.0; \
+            double x1 = (col_start + 1 < A->cols) ? x[col_start + 1] : 0.0; \
+            double x2 = (col_start + 2 < A->cols) ? x[col_start + 2] : 0.0; \
+            double x3 = (col_start + 3 < A->cols) ? x[col_start + 3] : 0.0; \
+                                                                            \
+            /* Fully unrolled 4×4 multiplication */                         \
+            s0 += block[0] * x0 + block[1] * x1 +                           \
+                  block[2] * x2 + block[3] * x3;                            \
+            s1 += block[4] * x0 + block[5] * x1 +                           \
+                  block[6] * x2 + block[7] * x3;                            \
+            s2 += block[8] * x0 + block[9] * x1 +                           \
+                  block[10] * x2 + block[11] * x3;                          \
+            s3 += block[12] * x0 + block[13] * x1 +                         \
+                  block[14] * x2 + block[15] * x3;                          \
+        }                                                                   \
+                                                                            \
+        if (row_start + 0 < A->rows) STORE(y[row_start + 0], s0, alpha, beta); \
+        if (row_start + 1 < A->rows) STORE(y[row_start + 1], s1, alpha, beta); \
+        if (row_start + 2 < A->rows) STORE(y[row_start + 2], s2, alpha, beta); \
+        if (row_start + 3 < A->rows) STORE(y[row_start + 3], s3, alpha, beta); \
+    }                                                                       \
+}
+
+MV_MODE_LIST(DEFINE_BCSR_PARALLEL_MV)
+
 void spmv_bcsr_parallel(const BCSR_Matrix *A, const double *x, double *y) {
-    memset(y, 0, A->rows * sizeof(double));
-    
-    #pragma omp parallel for schedule(dynamic, 64)
-    for (int br = 0; br < A->block_rows; br++) {
-        int row_start = br * 4;
-        
-        for (int kb = A->block_row_ptr[br]; kb < A->block_row_ptr[br + 1]; kb++) {
-            int bc = A->block_col_idx[kb];
-            int col_start = bc * 4;
-            const double *block = &A->block_val[kb * 16];
-            
-            // Register blocking: load 4 x values once
-            double x0 = (col_start + 0 < A->cols) ? x[col_start + 0] : 0.0;
-            double x1 = (col_start + 1 < A->cols) ? x[col_start + 1] : 0.0;
-            double x2 = (col_start + 2 < A->cols) ? x[col_start + 2] : 0.0;
-            double x3 = (col_start + 3 < A->cols) ? x[col_start + 3] : 0.0;
-            
-            // Fully unrolled 4×4 multiplication
-            if (row_start + 0 < A->rows) {
-                y[row_start + 0] += block[0] * x0 + block[1] * x1 + 
-                                     block[2] * x2 + block[3] * x3;
-            }
-            if (row_start + 1 < A->rows) {
-                y[row_start + 1] += block[4] * x0 + block[5] * x1 + 
-                                     block[6] * x2 + block[7] * x3;
-            }
-            if (row_start + 2 < A->rows) {
-                y[row_start + 2] += block[8] * x0 + block[9] * x1 + 
-                                     block[10] * x2 + block[11] * x3;
-            }
-            if (row_start + 3 < A->rows) {
-                y[row_start + 3] += block[12] * x0 + block[13] * x1 + 
-                                     block[14] * x2 + block[15] * x3;
-            }
-        }
-    }
+    bcsr_parallel_mv_a1_b0(1.0, A, x, 0.0, y);
+}
+
+void spmv_bcsr_parallel_mv(double alpha, const BCSR_Matrix *A, const double *x,
+                           double beta, double *y) {
+    MV_DISPATCH(bcsr_parallel_mv, alpha, A, x, beta, y);
 }
@@ -25,4 +25,13 @@
  */
 void spmv_bcsr_parallel(const BCSR_Matrix *A, const double *x, double *y);
 
+/**
+ * BCSR Parallel y = α·A·x + β·y
+ * 
+ * The four row sums of a block row are kept in registers and merged
+ * into y once (no memset, no repeated y += per block).
+ */
+void spmv_bcsr_parallel_mv(double alpha, const BCSR_Matrix *A, const double *x,
+                           double beta, double *y);
+
 #endif // BCSR_PARALLEL_H
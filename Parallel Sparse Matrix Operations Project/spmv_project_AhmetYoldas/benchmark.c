@@ -8,6 +8,7 @@
 #include <sys/time.h>
 #include <math.h>
 #include <omp.h>
+#include <unistd.h>
 
 #include "common.h"
 #include "csr_serial.h"
@@ -15,6 +16,20 @@
 #include "bcsr_parallel.h"
 #include "bucket_parallel.h"
 #include "bcsr_bucket_parallel.h"
+#include "csr64_parallel.h"
+#include "csrdu_parallel.h"
+#include "mixed_precision.h"
+#include "stream_parallel.h"
+#include "partition.h"
+#include "semiring.h"
+#include "spmspv.h"
+#include "pattern_parallel.h"
+#include "dict_parallel.h"
+#include "binned_parallel.h"
+#include "csr5_parallel.h"
+#include "merge_parallel.h"
+#include "csb_parallel.h"
+#include "mpk_parallel.h"
 
 // Timing
 static inline double get_time() {
@@ -38,6 +53,1086 @@ int verify(const double *y1, const double *y2, int n) {
     return max_diff < 1e-10;
 }
 
+// Max absolute difference (for extended reports)
+static double max_abs_diff(const double *y1, const double *y2, int n) {
+    double max_diff = 0.0;
+    for (int i = 0; i < n; i++) {
+        double diff = fabs(y1[i] - y2[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    return max_diff;
+}
+
+// Max relative error: max|y - y_ref| / max|y_ref|
+static double max_rel_error(const double *y_ref, const double *y, int n) {
+    double ref = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (fabs(y_ref[i]) > ref) ref = fabs(y_ref[i]);
+    }
+    return (ref > 0.0) ? max_abs_diff(y_ref, y, n) / ref : 0.0;
+}
+
+// Extended reports: rows of power-law matrices reach ~1e5 nonzeros, so a
+// reordered sum legitimately differs from y_ref by more than an absolute
+// 1e-10; compare against the scale of y_ref instead
+static int verify_rel(const double *y_ref, const double *y, int n) {
+    return max_rel_error(y_ref, y, n) < 1e-10;
+}
+
+// ============================================
+// EXTENDED: Index width (32-bit vs 64-bit row_ptr)
+// ============================================
+static void bench_index_width(const CSR_Matrix *A, const double *x, const double *y_ref) {
+    printf("----------------------------------------\n");
+    printf("INDEX WIDTH: 32-bit vs 64-bit row_ptr\n");
+    printf("   File: csr64_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    CSR64_Matrix *A64 = csr_to_csr64(A);
+    if (!A64) {
+        printf("   Not enough memory for the CSR64 copy\n\n");
+        return;
+    }
+    double *y = (double*)malloc(A->rows * sizeof(double));
+    
+    // Bytes streamed per SpMV: values + col_idx + row_ptr + x + y
+    double base_bytes = A->nnz * (sizeof(double) + sizeof(int)) +
+                        (double)A->cols * sizeof(double) +
+                        (double)A->rows * sizeof(double);
+    double bytes32 = base_bytes + (A->rows + 1.0) * sizeof(int);
+    double bytes64 = base_bytes + (A->rows + 1.0) * sizeof(int64_t);
+    
+    const char *names[4] = {"idx32 serial", "idx64 serial", "idx32 parallel", "idx64 parallel"};
+    double times[4];
+    int ok[4];
+    
+    for (int m = 0; m < 4; m++) {
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            double t = get_time();
+            if (m == 0) spmv_csr_idx32_serial(A, x, y);
+            else if (m == 1) spmv_csr_idx64_serial(A64, x, y);
+            else if (m == 2) spmv_csr_idx32_parallel(A, x, y);
+            else spmv_csr_idx64_parallel(A64, x, y);
+            times[m] = get_time() - t;
+        }
+        ok[m] = verify_rel(y_ref, y, A->rows);
+    }
+    
+    printf("   Bytes/SpMV: %.0f (idx32)  %.0f (idx64)  +%.2f%%\n",
+           bytes32, bytes64, 100.0 * (bytes64 - bytes32) / bytes32);
+    for (int m = 0; m < 4; m++) {
+        double bytes = (m % 2 == 0) ? bytes32 : bytes64;
+        printf("   %-15s %8.3f ms  %7.3f GFlop/s  %6.2f GB/s  %s\n",
+               names[m], times[m] * 1000,
+               compute_gflops(A->nnz, times[m]),
+               bytes / times[m] / 1e9,
+               ok[m] ? "✓ PASS" : "✗ FAIL");
+    }
+    printf("   idx64/idx32 time (parallel): %.3f×\n", times[3] / times[2]);
+    
+    // Matrices past 2³¹ nnz only exist as CSR64: check the file loader
+    // (the int64 layout of csr_write_binary) against the same product
+    const char *path = "spmv_csr64.bin";
+    CSR64_Matrix *L = NULL;
+    if (csr_write_binary(A, path) == 0) {
+        L = csr64_read_binary(path);
+        unlink(path);
+    }
+    if (L) {
+        spmv_csr_idx64_parallel(L, x, y);
+        printf("   CSR64 file loader: %lld nnz  %s\n", (long long)L->nnz,
+               verify_rel(y_ref, y, A->rows) ? "✓ PASS" : "✗ FAIL");
+        csr64_free(L);
+    }
+    printf("\n");
+    
+    free(y);
+    csr64_free(A64);
+}
+
+// ============================================
+// EXTENDED: CSR-DU (delta-encoded columns)
+// ============================================
+static void bench_csrdu(const CSR_Matrix *A, const double *x, const double *y_ref, int n) {
+    printf("----------------------------------------\n");
+    printf("CSR-DU: delta-encoded column indices\n");
+    printf("   File: csrdu_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    // 5-point stencil: small deltas, the case the format is built for
+    int nx = 8 * (int)sqrt((double)n);
+    if (nx < 256) nx = 256;
+    CSR_Matrix *stencil = csr_laplacian_2d(nx, nx);
+    double *xs = (double*)malloc(stencil->cols * sizeof(double));
+    double *ys_ref = (double*)malloc(stencil->rows * sizeof(double));
+    for (int j = 0; j < stencil->cols; j++) xs[j] = (double)rand() / RAND_MAX;
+    spmv_csr_serial(stencil, xs, ys_ref);
+    
+    const CSR_Matrix *mats[2] = {A, stencil};
+    const double *xv[2] = {x, xs};
+    const double *refs[2] = {y_ref, ys_ref};
+    const char *mat_names[2] = {"Random (benchmark)", "2D Laplacian"};
+    
+    for (int m = 0; m < 2; m++) {
+        const CSR_Matrix *M = mats[m];
+        CSRDU_Matrix *D = csr_to_csrdu(M);
+        double *y = (double*)malloc(M->rows * sizeof(double));
+        
+        double csr_bytes = M->nnz * (sizeof(double) + sizeof(int)) +
+                           (M->rows + 1.0) * sizeof(int);
+        double du_bytes = M->nnz * sizeof(double) + (double)D->grp_ctl[D->num_groups] +
+                          2.0 * (D->num_groups + 1.0) * sizeof(int);
+        
+        // Interleaved, best of 10
+        double t_csr = 1e30, t_du = 1e30;
+        int ok = 0;
+        for (int rep = 0; rep < 11; rep++) {
+            double t = get_time();
+            spmv_csr_parallel(M, xv[m], y);
+            t = get_time() - t;
+            if (rep > 0 && t < t_csr) t_csr = t;
+            
+            t = get_time();
+            spmv_csrdu_parallel(D, xv[m], y);
+            t = get_time() - t;
+            if (rep > 0 && t < t_du) t_du = t;
+            if (rep == 0) ok = verify_rel(refs[m], y, M->rows);
+        }
+        
+        printf("   %s: %d rows, %d nnz\n", mat_names[m], M->rows, M->nnz);
+        printf("   Column stream: %.3f bytes/nnz (CSR: %.3f)\n",
+               (double)D->grp_ctl[D->num_groups] / M->nnz, (double)sizeof(int));
+        printf("   Matrix bytes/nnz: %.3f (CSR: %.3f)  -%.1f%%\n",
+               du_bytes / M->nnz, csr_bytes / M->nnz,
+               100.0 * (csr_bytes - du_bytes) / csr_bytes);
+        printf("   CSR Parallel    %8.3f ms  %7.3f GFlop/s\n",
+               t_csr * 1000, compute_gflops(M->nnz, t_csr));
+        printf("   CSR-DU Parallel %8.3f ms  %7.3f GFlop/s  %s\n",
+               t_du * 1000, compute_gflops(M->nnz, t_du), ok ? "✓ PASS" : "✗ FAIL");
+        printf("   Speedup vs CSR Parallel: %.2f×\n", t_csr / t_du);
+        
+        free(y);
+        csrdu_free(D);
+    }
+    printf("\n");
+    
+    free(xs);
+    free(ys_ref);
+    csr_free(stencil);
+}
+
+// ============================================
+// EXTENDED: Mixed precision (float/bf16/fp16 values)
+// ============================================
+static void bench_mixed_precision(const CSR_Matrix *A, const BCSR_Matrix *B,
+                                  const double *x, const double *y_ref) {
+    printf("----------------------------------------\n");
+    printf("MIXED PRECISION: reduced values, double accumulation\n");
+    printf("   File: mixed_precision.c\n");
+#ifdef __F16C__
+    printf("   fp16 conversion: F16C\n");
+#else
+    printf("   fp16 conversion: software\n");
+#endif
+    printf("----------------------------------------\n");
+    
+    const char *type_names[3] = {"float", "bf16", "fp16"};
+    double *y = (double*)malloc(A->rows * sizeof(double));
+    
+    printf("   %-12s %10s %9s %9s %12s\n",
+           "Format", "bytes/nnz", "Time(ms)", "GFlop/s", "max rel err");
+    
+    // Double-precision references (same kernels as Methods 2 and 3)
+    double t = 0.0;
+    for (int rep = 0; rep < 2; rep++) {
+        double t0 = get_time();
+        spmv_csr_parallel(A, x, y);
+        t = get_time() - t0;
+    }
+    printf("   %-12s %10.3f %9.3f %9.3f %12.3e\n", "CSR double",
+           (A->nnz * 12.0 + (A->rows + 1.0) * 4) / A->nnz,
+           t * 1000, compute_gflops(A->nnz, t), max_rel_error(y_ref, y, A->rows));
+    
+    for (int vt = VALUE_F32; vt <= VALUE_F16; vt++) {
+        CSR_MP_Matrix *M = csr_to_csr_mp(A, vt);
+        for (int rep = 0; rep < 2; rep++) {
+            double t0 = get_time();
+            spmv_csr_mp_parallel(M, x, y);
+            t = get_time() - t0;
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "CSR %s", type_names[vt]);
+        printf("   %-12s %10.3f %9.3f %9.3f %12.3e\n", label,
+               (A->nnz * (4.0 + value_type_size(vt)) + (A->rows + 1.0) * 4) / A->nnz,
+               t * 1000, compute_gflops(A->nnz, t), max_rel_error(y_ref, y, A->rows));
+        csr_mp_free(M);
+    }
+    
+    for (int rep = 0; rep < 2; rep++) {
+        double t0 = get_time();
+        spmv_bcsr_parallel(B, x, y);
+        t = get_time() - t0;
+    }
+    printf("   %-12s %10.3f %9.3f %9.3f %12.3e\n", "BCSR double",
+           ((double)B->num_blocks * (16 * 8 + 4) + (B->block_rows + 1.0) * 4) / A->nnz,
+           t * 1000, compute_gflops(A->nnz, t), max_rel_error(y_ref, y, A->rows));
+    
+    for (int vt = VALUE_F32; vt <= VALUE_F16; vt++) {
+        BCSR_MP_Matrix *M = bcsr_to_bcsr_mp(B, vt);
+        for (int rep = 0; rep < 2; rep++) {
+            double t0 = get_time();
+            spmv_bcsr_mp_parallel(M, x, y);
+            t = get_time() - t0;
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "BCSR %s", type_names[vt]);
+        printf("   %-12s %10.3f %9.3f %9.3f %12.3e\n", label,
+               ((double)B->num_blocks * (16.0 * value_type_size(vt) + 4) +
+                (B->block_rows + 1.0) * 4) / A->nnz,
+               t * 1000, compute_gflops(A->nnz, t), max_rel_error(y_ref, y, A->rows));
+        bcsr_mp_free(M);
+    }
+    printf("\n");
+    
+    free(y);
+}
+
+// ============================================
+// EXTENDED: Out-of-core streaming
+// ============================================
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Median of n values (sorts v)
+static double median(double *v, int n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    return (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+#define STREAM_RUNS 5
+
+static void bench_stream(const CSR_Matrix *A, const double *x, const double *y_ref) {
+    const char *path = "spmv_stream.bin";
+    
+    printf("----------------------------------------\n");
+    printf("OUT-OF-CORE: streaming from %s\n", path);
+    printf("   File: stream_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    if (csr_write_binary(A, path) != 0) return;
+    CSR_File *F = csr_file_open(path);
+    if (!F) {
+        unlink(path);
+        return;
+    }
+    
+    // ~16 panels, but at least 64K nonzeros (768 KB) per panel
+    int64_t panel_nnz = A->nnz / 16;
+    if (panel_nnz < 65536) panel_nnz = 65536;
+    
+    double *y = (double*)malloc(A->rows * sizeof(double));
+    double raw[STREAM_RUNS], stream[STREAM_RUNS], io[STREAM_RUNS], wait[STREAM_RUNS];
+    Stream_Stats st;
+    int ok = 1;
+    
+    // A file this small finishes in milliseconds, so single runs swing
+    // widely: repeat the cold measurements and report the median
+    for (int r = 0; r < STREAM_RUNS; r++) {
+        csr_file_drop_cache(F);
+        raw[r] = csr_file_read_bandwidth(F, panel_nnz * 12);
+        
+        csr_file_drop_cache(F);
+        int err = spmv_csr_stream(F, x, y, panel_nnz, &st);
+        ok = ok && !err && verify_rel(y_ref, y, A->rows);
+        
+        stream[r] = st.total_time;
+        io[r] = st.io_time;
+        wait[r] = st.io_wait_time;
+    }
+    
+    double raw_gbs = median(raw, STREAM_RUNS);
+    double t = median(stream, STREAM_RUNS);
+    double stream_gbs = st.bytes_read / t / 1e9;
+    
+    printf("   Panels: %d × ~%lld nnz (%d buffers), %.1f MB, median of %d runs\n",
+           st.num_panels, (long long)panel_nnz, STREAM_BUFFERS,
+           st.bytes_read / 1e6, STREAM_RUNS);
+    printf("   Raw read (cold):   %7.3f GB/s\n", raw_gbs);
+    printf("   Streaming SpMV:    %7.3f GB/s  %8.3f ms  %7.3f GFlop/s  %s\n",
+           stream_gbs, t * 1000, compute_gflops(A->nnz, t), ok ? "✓ PASS" : "✗ FAIL");
+    printf("   Disk efficiency:   %.1f%% of raw\n", 100.0 * stream_gbs / raw_gbs);
+    printf("   pread time: %.3f ms, compute waited: %.3f ms\n",
+           median(io, STREAM_RUNS) * 1000, median(wait, STREAM_RUNS) * 1000);
+    printf("   (file fits in RAM; ./stream_bench measures one larger than RAM)\n\n");
+    
+    free(y);
+    csr_file_close(F);
+    unlink(path);
+}
+
+// ============================================
+// EXTENDED: Graph partitioning (distributed SpMV traffic)
+// ============================================
+static void print_partition(const char *label, const CSR_Matrix *A,
+                            const int *part, int nparts, double t) {
+    Partition_Stats st;
+    partition_stats(A, part, nparts, &st);
+    printf("   %-22s %3d %10d %10d %9d %7.3f %9.2f\n", label, nparts,
+           st.edge_cut, st.halo_volume, st.max_halo, st.imbalance, t * 1000);
+}
+
+static void bench_partition(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("GRAPH PARTITIONING: halo volume for distributed SpMV\n");
+    printf("   File: partition.c\n");
+    printf("----------------------------------------\n");
+    
+    // Structured matrix with a scrambled row order: a contiguous split
+    // has no locality, the partitioner should recover the grid
+    int nx = (int)sqrt((double)n);
+    if (nx < 16) nx = 16;
+    CSR_Matrix *grid = csr_laplacian_2d(nx, nx);
+    int *perm = (int*)malloc(grid->rows * sizeof(int));
+    for (int i = 0; i < grid->rows; i++) perm[i] = i;
+    for (int i = grid->rows - 1; i > 0; i--) {
+        int r = rand() % (i + 1);
+        int tmp = perm[i]; perm[i] = perm[r]; perm[r] = tmp;
+    }
+    CSR_Matrix *scrambled = csr_permute(grid, perm);
+    
+    const CSR_Matrix *mats[2] = {scrambled, A};
+    const char *mat_names[2] = {"2D Laplacian (scrambled)", "Random (benchmark matrix)"};
+    int *part = (int*)malloc((grid->rows > A->rows ? grid->rows : A->rows) * sizeof(int));
+    
+    for (int m = 0; m < 2; m++) {
+        const CSR_Matrix *M = mats[m];
+        printf("   %s: %d rows, %d nnz\n", mat_names[m], M->rows, M->nnz);
+        printf("   %-22s %3s %10s %10s %9s %7s %9s\n",
+               "Partition", "k", "edge cut", "halo", "max halo", "imbal", "time(ms)");
+        for (int nparts = 4; nparts <= 16; nparts *= 2) {
+            partition_contiguous(M->rows, nparts, part);
+            print_partition("Contiguous rows", M, part, nparts, 0.0);
+            
+            double t = get_time();
+            int *ml = graph_partition(M, nparts, 42);
+            t = get_time() - t;
+            print_partition("Multilevel (HEM+FM)", M, ml, nparts, t);
+            free(ml);
+        }
+        printf("\n");
+    }
+    
+    free(part);
+    free(perm);
+    csr_free(grid);
+    csr_free(scrambled);
+}
+
+// ============================================
+// EXTENDED: Semiring-generic SpMV
+// ============================================
+typedef void (*CSR_Kernel)(const CSR_Matrix *A, const double *x, double *y);
+
+static double time_csr_kernel(CSR_Kernel f, const CSR_Matrix *A,
+                              const double *x, double *y) {
+    double t = 0.0;
+    for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+        double t0 = get_time();
+        f(A, x, y);
+        t = get_time() - t0;
+    }
+    return t;
+}
+
+static void bench_semiring(const CSR_Matrix *A, const double *x, const double *y_ref) {
+    printf("----------------------------------------\n");
+    printf("SEMIRING SpMV: generated (⊕, ⊗) kernels\n");
+    printf("   File: semiring.c\n");
+    printf("----------------------------------------\n");
+    
+    double *y = (double*)malloc(A->rows * sizeof(double));
+    double *y_serial = (double*)malloc(A->rows * sizeof(double));
+    
+    // plus_times must match the hand-written kernels (no slowdown)
+    double t_hand = time_csr_kernel(spmv_csr_parallel, A, x, y);
+    double t_gen = time_csr_kernel(spmv_csr_parallel_plus_times, A, x, y);
+    int ok = verify_rel(y_ref, y, A->rows);
+    printf("   CSR Parallel:    hand %8.3f ms   plus_times %8.3f ms   ratio %.2f×  %s\n",
+           t_hand * 1000, t_gen * 1000, t_gen / t_hand, ok ? "✓ PASS" : "✗ FAIL");
+    
+    t_hand = time_csr_kernel(spmv_bucket_parallel, A, x, y);
+    t_gen = time_csr_kernel(spmv_bucket_parallel_plus_times, A, x, y);
+    ok = verify_rel(y_ref, y, A->rows);
+    printf("   Bucket Parallel: hand %8.3f ms   plus_times %8.3f ms   ratio %.2f×  %s\n\n",
+           t_hand * 1000, t_gen * 1000, t_gen / t_hand, ok ? "✓ PASS" : "✗ FAIL");
+    
+    // Every semiring: parallel variants against its serial instantiation
+    printf("   %-11s %12s %12s %9s\n", "Semiring", "CSR (ms)", "Bucket (ms)", "Check");
+#define BENCH_SEMIRING(NAME, ZERO, ADD, MUL)                                        \
+    {                                                                               \
+        spmv_csr_serial_##NAME(A, x, y_serial);                                     \
+        double tc = time_csr_kernel(spmv_csr_parallel_##NAME, A, x, y);             \
+        int okc = max_abs_diff(y_serial, y, A->rows) == 0.0;                        \
+        double tb = time_csr_kernel(spmv_bucket_parallel_##NAME, A, x, y);          \
+        int okb = max_abs_diff(y_serial, y, A->rows) == 0.0;                        \
+        printf("   %-11s %12.3f %12.3f %9s\n", #NAME, tc * 1000, tb * 1000,        \
+               (okc && okb) ? "✓ PASS" : "✗ FAIL");                                 \
+    }
+    SEMIRING_LIST(BENCH_SEMIRING)
+#undef BENCH_SEMIRING
+    printf("\n");
+    
+    free(y);
+    free(y_serial);
+}
+
+// ============================================
+// EXTENDED: SpMSpV (sparse frontier) vs pull SpMV
+// ============================================
+static void bench_spmspv(const CSR_Matrix *A) {
+    printf("----------------------------------------\n");
+    printf("SpMSpV: CSC push vs CSR pull (direction-optimizing)\n");
+    printf("   File: spmspv.c\n");
+    printf("----------------------------------------\n");
+    
+    CSC_Matrix *A_csc = csr_to_csc(A);
+    SpMSpV_Workspace *ws = spmspv_workspace_alloc(A->rows, A->cols);
+    Sparse_Vector *xs = sparse_vector_alloc(A->cols, A->cols);
+    Sparse_Vector *ys = sparse_vector_alloc(A->rows, A->rows);
+    double *xd = (double*)calloc(A->cols, sizeof(double));
+    double *yd = (double*)malloc(A->rows * sizeof(double));
+    double *yp = (double*)malloc(A->rows * sizeof(double));
+    
+    const double fractions[6] = {0.001, 0.005, 0.01, 0.05, 0.2, 0.5};
+    
+    printf("   %9s %8s %10s %10s %10s %7s %7s\n",
+           "frontier", "x nnz", "push(ms)", "pull(ms)", "auto(ms)", "auto", "check");
+    
+    for (int f = 0; f < 6; f++) {
+        // Frontier: every column with probability fractions[f]
+        memset(xd, 0, A->cols * sizeof(double));
+        xs->nnz = 0;
+        for (int j = 0; j < A->cols; j++) {
+            if ((double)rand() / RAND_MAX < fractions[f]) {
+                xs->idx[xs->nnz] = j;
+                xs->val[xs->nnz] = (double)rand() / RAND_MAX + 0.5;
+                xd[j] = xs->val[xs->nnz];
+                xs->nnz++;
+            }
+        }
+        
+        double t_push = 0.0, t_pull = 0.0, t_auto = 0.0;
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            double t = get_time();
+            spmspv_csc_parallel(A_csc, xs, ys, ws);
+            t_push = get_time() - t;
+        }
+        
+        // Scatter push result for checking
+        memset(yp, 0, A->rows * sizeof(double));
+        for (int e = 0; e < ys->nnz; e++) yp[ys->idx[e]] = ys->val[e];
+        
+        for (int rep = 0; rep < 2; rep++) {
+            double t = get_time();
+            spmv_csr_parallel(A, xd, yd);
+            t_pull = get_time() - t;
+        }
+        int ok = verify_rel(yd, yp, A->rows);
+        
+        int dir = 0;
+        for (int rep = 0; rep < 2; rep++) {
+            double t = get_time();
+            dir = spmspv_direction_optimizing(A, A_csc, xs, ys, ws);
+            t_auto = get_time() - t;
+        }
+        memset(yp, 0, A->rows * sizeof(double));
+        for (int e = 0; e < ys->nnz; e++) yp[ys->idx[e]] = ys->val[e];
+        ok = ok && verify_rel(yd, yp, A->rows);
+        
+        printf("   %8.1f%% %8d %10.3f %10.3f %10.3f %7s %7s\n",
+               fractions[f] * 100, xs->nnz, t_push * 1000, t_pull * 1000,
+               t_auto * 1000, dir ? "pull" : "push", ok ? "✓ PASS" : "✗ FAIL");
+    }
+    printf("\n");
+    
+    free(xd);
+    free(yd);
+    free(yp);
+    sparse_vector_free(xs);
+    sparse_vector_free(ys);
+    spmspv_workspace_free(ws);
+    csc_free(A_csc);
+}
+
+// ============================================
+// EXTENDED: Pattern-only (values-free) kernels
+// ============================================
+static void bench_pattern(const CSR_Matrix *A, const double *x) {
+    printf("----------------------------------------\n");
+    printf("PATTERN-ONLY: values-free CSR / Bucket / BCSR\n");
+    printf("   File: pattern_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    // The benchmark matrix has random values, so detection must refuse it
+    CSR_Pattern_Matrix *rejected = csr_to_pattern(A);
+    printf("   Random-valued matrix uniform: %s\n", rejected ? "yes" : "no");
+    csr_pattern_free(rejected);
+    
+    // Adjacency matrix: same structure, every value 1.0
+    CSR_Matrix *G = (CSR_Matrix*)malloc(sizeof(CSR_Matrix));
+    G->rows = A->rows;
+    G->cols = A->cols;
+    G->nnz = A->nnz;
+    G->row_ptr = (int*)malloc((A->rows + 1) * sizeof(int));
+    G->col_idx = (int*)malloc((size_t)A->nnz * sizeof(int));
+    G->values = (double*)malloc((size_t)A->nnz * sizeof(double));
+    memcpy(G->row_ptr, A->row_ptr, (A->rows + 1) * sizeof(int));
+    memcpy(G->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    for (int k = 0; k < A->nnz; k++) G->values[k] = 1.0;
+    
+    BCSR_Matrix *GB = csr_to_bcsr(G);
+    CSR_Pattern_Matrix *P = csr_to_pattern(G);
+    BCSR_Pattern_Matrix *PB = csr_to_bcsr_pattern(G);
+    printf("   Adjacency matrix uniform: %s (value = %.1f)\n",
+           P ? "yes" : "no", P ? P->value : 0.0);
+    
+    double *y_ref = (double*)malloc(A->rows * sizeof(double));
+    double *y = (double*)malloc(A->rows * sizeof(double));
+    spmv_csr_serial(G, x, y_ref);
+    
+    double csr_bytes = A->nnz * (sizeof(double) + sizeof(int)) + (A->rows + 1.0) * sizeof(int);
+    double pat_bytes = A->nnz * (double)sizeof(int) + (A->rows + 1.0) * sizeof(int);
+    double bcsr_bytes = GB->num_blocks * (16.0 * sizeof(double) + sizeof(int)) +
+                        (GB->block_rows + 1.0) * sizeof(int);
+    double mask_bytes = GB->num_blocks * (double)(sizeof(uint16_t) + sizeof(int)) +
+                        (GB->block_rows + 1.0) * sizeof(int);
+    printf("   Matrix bytes/nnz: CSR %.2f → %.2f   BCSR %.2f → %.2f\n",
+           csr_bytes / A->nnz, pat_bytes / A->nnz,
+           bcsr_bytes / A->nnz, mask_bytes / A->nnz);
+    
+    const char *names[6] = {"CSR Parallel", "CSR pattern", "Bucket Parallel",
+                            "Bucket pattern", "BCSR Parallel", "BCSR mask"};
+    double times[6];
+    int ok[6];
+    
+    for (int m = 0; m < 6; m++) {
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            double t = get_time();
+            if (m == 0) spmv_csr_parallel(G, x, y);
+            else if (m == 1) spmv_csr_pattern_parallel(P, x, y);
+            else if (m == 2) spmv_bucket_parallel(G, x, y);
+            else if (m == 3) spmv_bucket_pattern_parallel(P, x, y);
+            else if (m == 4) spmv_bcsr_parallel(GB, x, y);
+            else spmv_bcsr_pattern_parallel(PB, x, y);
+            times[m] = get_time() - t;
+        }
+        ok[m] = verify_rel(y_ref, y, A->rows);
+    }
+    
+    for (int m = 0; m < 6; m++) {
+        printf("   %-16s %8.3f ms  %7.3f GFlop/s  %s",
+               names[m], times[m] * 1000, compute_gflops(A->nnz, times[m]),
+               ok[m] ? "✓ PASS" : "✗ FAIL");
+        if (m % 2 == 1) printf("  (%.2f×)", times[m - 1] / times[m]);
+        printf("\n");
+    }
+    printf("\n");
+    
+    free(y_ref);
+    free(y);
+    csr_pattern_free(P);
+    bcsr_pattern_free(PB);
+    bcsr_free(GB);
+    csr_free(G);
+}
+
+// ============================================
+// EXTENDED: Dictionary-compressed values
+// ============================================
+static void bench_dict(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("DICTIONARY VALUES: 1-/2-byte codes + table\n");
+    printf("   File: dict_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    // 5-point stencil (2 distinct values)
+    int nx = 8 * (int)sqrt((double)n);
+    if (nx < 256) nx = 256;
+    CSR_Matrix *stencil = csr_laplacian_2d(nx, nx);
+    
+    // Benchmark matrix quantized to 1/1024 steps (~1K distinct values)
+    CSR_Matrix *quant = csr_alloc(A->rows, A->cols, A->nnz);
+    memcpy(quant->row_ptr, A->row_ptr, (A->rows + 1) * sizeof(int));
+    memcpy(quant->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    for (int k = 0; k < A->nnz; k++) {
+        quant->values[k] = floor(A->values[k] * 1024.0) / 1024.0;
+    }
+    
+    const CSR_Matrix *mats[3] = {stencil, quant, A};
+    const char *mat_names[3] = {"2D Laplacian", "Quantized random", "Random (benchmark)"};
+    
+    printf("   %-20s %8s %6s %9s %10s %10s %8s %7s\n", "matrix", "distinct", "code",
+           "bytes/nnz", "CSR(ms)", "dict(ms)", "speedup", "check");
+    
+    for (int m = 0; m < 3; m++) {
+        const CSR_Matrix *M = mats[m];
+        CSR_Dict_Matrix *D = csr_to_csr_dict(M);
+        if (!D) {
+            printf("   %-20s %8s   (>%d distinct values, stays CSR)\n",
+                   mat_names[m], "-", DICT_MAX_U16);
+            continue;
+        }
+        
+        double *xm = (double*)malloc(M->cols * sizeof(double));
+        double *y_ref = (double*)malloc(M->rows * sizeof(double));
+        double *y = (double*)malloc(M->rows * sizeof(double));
+        for (int j = 0; j < M->cols; j++) xm[j] = (double)rand() / RAND_MAX;
+        
+        double t_csr = 0.0, t_dict = 0.0;
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            double t = get_time();
+            spmv_csr_parallel(M, xm, y_ref);
+            t_csr = get_time() - t;
+        }
+        for (int rep = 0; rep < 2; rep++) {
+            double t = get_time();
+            spmv_csr_dict_parallel(D, xm, y);
+            t_dict = get_time() - t;
+        }
+        int ok = verify_rel(y_ref, y, M->rows);
+        
+        double bytes = M->nnz * (double)(sizeof(int) + D->code_bytes) +
+                       (M->rows + 1.0) * sizeof(int) +
+                       D->table_size * (double)sizeof(double);
+        printf("   %-20s %8d %5dB %9.2f %10.3f %10.3f %7.2f× %7s\n",
+               mat_names[m], D->table_size, D->code_bytes, bytes / M->nnz,
+               t_csr * 1000, t_dict * 1000, t_csr / t_dict,
+               ok ? "✓ PASS" : "✗ FAIL");
+        
+        free(xm);
+        free(y_ref);
+        free(y);
+        csr_dict_free(D);
+    }
+    printf("   (CSR: %.2f bytes/nnz)\n\n",
+           (double)(sizeof(double) + sizeof(int)));
+    
+    csr_free(stencil);
+    csr_free(quant);
+}
+
+// ============================================
+// EXTENDED: Row-length-binned hybrid scheduler
+// ============================================
+static void bench_binned(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("ROW-LENGTH BINS: short (SIMD) / medium / long (split)\n");
+    printf("   File: binned_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    // Heavy-tailed rows (Pareto lengths) next to the uniform benchmark matrix
+    int np = (10 * n < 20000) ? 20000 : 10 * n;
+    CSR_Matrix *skewed = csr_power_law(np, 16);
+    
+    const CSR_Matrix *mats[2] = {skewed, A};
+    const char *mat_names[2] = {"Power-law rows", "Random (benchmark)"};
+    
+    for (int m = 0; m < 2; m++) {
+        const CSR_Matrix *M = mats[m];
+        int max_len = 0, short_nnz = 0;
+        for (int i = 0; i < M->rows; i++) {
+            int len = M->row_ptr[i + 1] - M->row_ptr[i];
+            if (len > max_len) max_len = len;
+            if (len <= BIN_SHORT_MAX) short_nnz += len;
+        }
+        
+        double t0 = get_time();
+        Binned_Plan *P = binned_plan_create(M);
+        double t_setup = get_time() - t0;
+        
+        double *xm = (double*)malloc(M->cols * sizeof(double));
+        double *y_ref = (double*)malloc(M->rows * sizeof(double));
+        double *y = (double*)malloc(M->rows * sizeof(double));
+        for (int j = 0; j < M->cols; j++) xm[j] = (double)rand() / RAND_MAX;
+        spmv_csr_serial(M, xm, y_ref);
+        
+        printf("   %s: %d rows, %d nnz, max row %d\n",
+               mat_names[m], M->rows, M->nnz, max_len);
+        int slice_nnz = P->slice_ptr[P->num_slices];
+        printf("   Bins: %d short (%d slices, %.0f%% padding)  %d medium  "
+               "%d long (%d pieces)  setup %.3f ms\n",
+               P->num_short, P->num_slices,
+               slice_nnz > 0 ? 100.0 * (slice_nnz - short_nnz) / slice_nnz : 0.0,
+               P->num_medium, P->num_long, P->num_pieces, t_setup * 1000);
+        
+        const char *names[3] = {"CSR Parallel", "Bucket Parallel", "Binned"};
+        double times[3];
+        int ok[3];
+        // Interleaved, best of 10 per kernel: a single timed run on a
+        // shared machine swings by more than the difference measured here
+        for (int k = 0; k < 3; k++) times[k] = 1e30;
+        for (int rep = 0; rep < 11; rep++) {   // first round is warm-up
+            for (int k = 0; k < 3; k++) {
+                double t = get_time();
+                if (k == 0) spmv_csr_parallel(M, xm, y);
+                else if (k == 1) spmv_bucket_parallel(M, xm, y);
+                else spmv_binned_parallel(M, P, xm, y);
+                t = get_time() - t;
+                if (rep > 0 && t < times[k]) times[k] = t;
+                if (rep == 0) ok[k] = verify_rel(y_ref, y, M->rows);
+            }
+        }
+        for (int k = 0; k < 3; k++) {
+            printf("   %-16s %8.3f ms  %7.3f GFlop/s  %s\n",
+                   names[k], times[k] * 1000, compute_gflops(M->nnz, times[k]),
+                   ok[k] ? "✓ PASS" : "✗ FAIL");
+        }
+        printf("   Binned speedup vs Bucket: %.2f×\n", times[1] / times[2]);
+        
+        free(xm);
+        free(y_ref);
+        free(y);
+        binned_plan_free(P);
+    }
+    printf("\n");
+    
+    csr_free(skewed);
+}
+
+// ============================================
+// EXTENDED: CSR5 tiles vs merge-path balancing
+// ============================================
+static void bench_csr5(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("CSR5 TILES vs MERGE-PATH: skew-insensitive SpMV\n");
+    printf("   Files: csr5_parallel.c, merge_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    int np = (10 * n < 20000) ? 20000 : 10 * n;
+    CSR_Matrix *skewed = csr_power_law(np, 16);
+    
+    // Same skewed matrix with every 4th row emptied (exercises nz_rows)
+    CSR_Matrix *holes = csr_alloc(skewed->rows, skewed->cols, skewed->nnz);
+    int kh = 0;
+    for (int i = 0; i < skewed->rows; i++) {
+        if (i % 4 != 3) {
+            for (int k = skewed->row_ptr[i]; k < skewed->row_ptr[i + 1]; k++) {
+                holes->col_idx[kh] = skewed->col_idx[k];
+                holes->values[kh++] = skewed->values[k];
+            }
+        }
+        holes->row_ptr[i + 1] = kh;
+    }
+    holes->nnz = kh;
+    
+    const CSR_Matrix *mats[3] = {skewed, holes, A};
+    const char *mat_names[3] = {"Power-law rows", "Power-law + empty rows", "Random (benchmark)"};
+    
+    for (int m = 0; m < 3; m++) {
+        const CSR_Matrix *M = mats[m];
+        
+        double t0 = get_time();
+        CSR5_Matrix *C = csr_to_csr5(M);
+        double t_conv = get_time() - t0;
+        double *carry = (double*)malloc((C->num_tiles + 1) * sizeof(double));
+        
+        double *xm = (double*)malloc(M->cols * sizeof(double));
+        double *y_ref = (double*)malloc(M->rows * sizeof(double));
+        double *y = (double*)malloc(M->rows * sizeof(double));
+        for (int j = 0; j < M->cols; j++) xm[j] = (double)rand() / RAND_MAX;
+        spmv_csr_serial(M, xm, y_ref);
+        
+        const char *names[3] = {"CSR Parallel", "Merge-path", "CSR5"};
+        double times[3];
+        int ok[3];
+        for (int k = 0; k < 3; k++) times[k] = 1e30;
+        for (int rep = 0; rep < 11; rep++) {   // interleaved, best of 10
+            for (int k = 0; k < 3; k++) {
+                // Stale y must not leak into rows a kernel skips
+                for (int i = 0; i < M->rows; i++) y[i] = NAN;
+                double t = get_time();
+                if (k == 0) spmv_csr_parallel(M, xm, y);
+                else if (k == 1) spmv_merge_parallel(M, xm, y);
+                else spmv_csr5_parallel(C, xm, y, carry);
+                t = get_time() - t;
+                if (rep > 0 && t < times[k]) times[k] = t;
+                if (rep == 0) ok[k] = verify_rel(y_ref, y, M->rows);
+            }
+        }
+        
+        printf("   %s: %d rows, %d nnz, %d tiles\n",
+               mat_names[m], M->rows, M->nnz, C->num_tiles);
+        for (int k = 0; k < 3; k++) {
+            printf("   %-16s %8.3f ms  %7.3f GFlop/s  %s\n",
+                   names[k], times[k] * 1000, compute_gflops(M->nnz, times[k]),
+                   ok[k] ? "✓ PASS" : "✗ FAIL");
+        }
+        printf("   CSR5 conversion: %.3f ms (%.2f SpMVs)\n",
+               t_conv * 1000, t_conv / times[2]);
+        
+        free(xm);
+        free(y_ref);
+        free(y);
+        free(carry);
+        csr5_free(C);
+    }
+    printf("\n");
+    
+    csr_free(skewed);
+    csr_free(holes);
+}
+
+// ============================================
+// EXTENDED: CSB for A·x and Aᵀ·x
+// ============================================
+static void bench_csb(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("CSB: A·x and Aᵀ·x from one matrix copy\n");
+    printf("   File: csb_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    int np = (10 * n < 20000) ? 20000 : 10 * n;
+    CSR_Matrix *skewed = csr_power_law(np, 16);
+    
+    const CSR_Matrix *mats[2] = {A, skewed};
+    const char *mat_names[2] = {"Random (benchmark)", "Power-law rows"};
+    
+    for (int m = 0; m < 2; m++) {
+        const CSR_Matrix *M = mats[m];
+        CSB_Matrix *B = csr_to_csb(M);
+        
+        // Transpose baseline: CSC of A read as CSR of Aᵀ (second copy)
+        CSC_Matrix *C = csr_to_csc(M);
+        CSR_Matrix At = {.rows = M->cols, .cols = M->rows, .nnz = M->nnz,
+                         .row_ptr = C->col_ptr, .col_idx = C->row_idx, .values = C->values};
+        
+        int len = (M->rows > M->cols) ? M->rows : M->cols;
+        double *xm = (double*)malloc(len * sizeof(double));
+        double *y_ref = (double*)malloc(len * sizeof(double));
+        double *yt_ref = (double*)calloc(len, sizeof(double));
+        double *y = (double*)malloc(len * sizeof(double));
+        for (int j = 0; j < len; j++) xm[j] = (double)rand() / RAND_MAX;
+        
+        spmv_csr_serial(M, xm, y_ref);
+        for (int i = 0; i < M->rows; i++) {
+            for (int k = M->row_ptr[i]; k < M->row_ptr[i + 1]; k++) {
+                yt_ref[M->col_idx[k]] += M->values[k] * xm[i];
+            }
+        }
+        
+        const char *names[4] = {"CSR A·x", "CSB A·x", "CSC A^T·x", "CSB A^T·x"};
+        double times[4];
+        int ok[4];
+        for (int k = 0; k < 4; k++) times[k] = 1e30;
+        for (int rep = 0; rep < 11; rep++) {   // interleaved, best of 10
+            for (int k = 0; k < 4; k++) {
+                double t = get_time();
+                if (k == 0) spmv_csr_parallel(M, xm, y);
+                else if (k == 1) spmv_csb_parallel(B, xm, y);
+                else if (k == 2) spmv_csr_parallel(&At, xm, y);
+                else spmv_csb_transpose_parallel(B, xm, y);
+                t = get_time() - t;
+                if (rep > 0 && t < times[k]) times[k] = t;
+                if (rep == 0) {
+                    ok[k] = (k < 2) ? verify_rel(y_ref, y, M->rows)
+                                    : verify_rel(yt_ref, y, M->cols);
+                }
+            }
+        }
+        
+        double csr_bytes = M->nnz * (sizeof(double) + sizeof(int)) + (M->rows + 1.0) * sizeof(int);
+        double csb_bytes = M->nnz * (sizeof(double) + sizeof(uint32_t)) +
+                           ((double)B->block_rows * B->block_cols + 1.0) * sizeof(int);
+        printf("   %s: β = %d, %d×%d blocks\n", mat_names[m], B->beta,
+               B->block_rows, B->block_cols);
+        printf("   Storage: CSB %.2f MB   CSR+CSC %.2f MB\n",
+               csb_bytes / 1e6, 2.0 * csr_bytes / 1e6);
+        for (int k = 0; k < 4; k++) {
+            printf("   %-12s %8.3f ms  %7.3f GFlop/s  %s\n",
+                   names[k], times[k] * 1000, compute_gflops(M->nnz, times[k]),
+                   ok[k] ? "✓ PASS" : "✗ FAIL");
+        }
+        printf("   CSB A^T·x / A·x time: %.2f×\n", times[3] / times[1]);
+        
+        free(xm);
+        free(y_ref);
+        free(yt_ref);
+        free(y);
+        csc_free(C);
+        csb_free(B);
+    }
+    printf("\n");
+    
+    csr_free(skewed);
+}
+
+// ============================================
+// EXTENDED: Matrix powers [Ax, A²x, …, Aᵏx]
+// ============================================
+static void bench_mpk(const CSR_Matrix *A, int n) {
+    printf("----------------------------------------\n");
+    printf("MATRIX POWERS: cache-blocked A^k·x vs k SpMVs\n");
+    printf("   File: mpk_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    const int k = 4;
+    // At least 1M rows (~64 MB of CSR), so the k plain sweeps stream the
+    // matrix from memory instead of the last-level cache
+    int nx = 8 * (int)sqrt((double)n);
+    if (nx < 1024) nx = 1024;
+    CSR_Matrix *stencil = csr_laplacian_2d(nx, nx);
+    
+    const CSR_Matrix *mats[2] = {stencil, A};
+    const char *mat_names[2] = {"2D Laplacian", "Random (benchmark)"};
+    
+    for (int m = 0; m < 2; m++) {
+        const CSR_Matrix *M = mats[m];
+        MPK_Plan *P = mpk_plan_create(M, k, 0);
+        if (!P) {
+            printf("   %s: skipped (matrix is not square)\n", mat_names[m]);
+            continue;
+        }
+        
+        double *xm = (double*)malloc(M->rows * sizeof(double));
+        double *V_ref = (double*)malloc((size_t)k * M->rows * sizeof(double));
+        double *V = (double*)malloc((size_t)k * M->rows * sizeof(double));
+        for (int i = 0; i < M->rows; i++) xm[i] = (double)rand() / RAND_MAX;
+        
+        double t_naive = 0.0, t_mpk = 0.0;
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            double t = get_time();
+            for (int j = 0; j < k; j++) {
+                spmv_bucket_parallel(M, (j == 0) ? xm : V_ref + (size_t)(j - 1) * M->rows,
+                                     V_ref + (size_t)j * M->rows);
+            }
+            t_naive = get_time() - t;
+        }
+        for (int rep = 0; rep < 2; rep++) {
+            double t = get_time();
+            spmv_mpk_parallel(M, P, xm, V);
+            t_mpk = get_time() - t;
+        }
+        
+        // Compare each power relative to its own scale
+        double err = 0.0;
+        for (int j = 0; j < k; j++) {
+            double e = max_rel_error(V_ref + (size_t)j * M->rows, V + (size_t)j * M->rows, M->rows);
+            if (e > err) err = e;
+        }
+        
+        // Matrix traffic: k full sweeps vs one pass over each step's window
+        double nnz_bytes = sizeof(double) + sizeof(int);
+        double naive_bytes = k * (M->nnz * nnz_bytes + (M->rows + 1.0) * sizeof(int));
+        double mpk_bytes = P->traffic_nnz * nnz_bytes + (M->rows + 1.0) * sizeof(int);
+        
+        printf("   %s (%d rows, k = %d): %d steps of %d rows\n",
+               mat_names[m], M->rows, k, P->num_steps, P->bucket_rows);
+        printf("   Modelled matrix traffic: %.2f MB (k SpMVs) → %.2f MB (MPK), saved %.1f%%\n",
+               naive_bytes / 1e6, mpk_bytes / 1e6,
+               100.0 * (naive_bytes - mpk_bytes) / naive_bytes);
+        printf("   %d × Bucket SpMV %8.3f ms\n", k, t_naive * 1000);
+        printf("   MPK              %8.3f ms  %.2f× measured  max rel err %.1e %s\n",
+               t_mpk * 1000, t_naive / t_mpk, err,
+               err < 1e-12 ? "✓ PASS" : "✗ FAIL");
+        
+        free(xm);
+        free(V_ref);
+        free(V);
+        mpk_plan_free(P);
+    }
+    printf("\n");
+    
+    csr_free(stencil);
+}
+
+// ============================================
+// EXTENDED: Fused y = α·A·x + β·y
+// ============================================
+static void run_mv(int method, double alpha, const CSR_Matrix *A, const BCSR_Matrix *B,
+                   const double *x, double beta, double *y) {
+    if (method == 0) spmv_csr_serial_mv(alpha, A, x, beta, y);
+    else if (method == 1) spmv_csr_parallel_mv(alpha, A, x, beta, y);
+    else if (method == 2) spmv_bcsr_parallel_mv(alpha, B, x, beta, y);
+    else if (method == 3) spmv_bucket_parallel_mv(alpha, A, x, beta, y);
+    else spmv_bcsr_bucket_parallel_mv(alpha, B, x, beta, y);
+}
+
+static void run_spmv(int method, const CSR_Matrix *A, const BCSR_Matrix *B,
+                     const double *x, double *y) {
+    if (method == 0) spmv_csr_serial(A, x, y);
+    else if (method == 1) spmv_csr_parallel(A, x, y);
+    else if (method == 2) spmv_bcsr_parallel(B, x, y);
+    else if (method == 3) spmv_bucket_parallel(A, x, y);
+    else spmv_bcsr_bucket_parallel(B, x, y);
+}
+
+static void bench_alpha_beta(const CSR_Matrix *A, const BCSR_Matrix *B,
+                             const double *x, const double *Ax) {
+    printf("----------------------------------------\n");
+    printf("FUSED α/β: y = α·A·x + β·y (all 5 methods)\n");
+    printf("   Files: csr_serial.c … bcsr_bucket_parallel.c\n");
+    printf("----------------------------------------\n");
+    
+    const char *names[5] = {"CSR Serial", "CSR Parallel", "BCSR Parallel",
+                            "Bucket Parallel", "BCSR+Bucket"};
+    const double cases[6][2] = {{1.0, 0.0}, {2.5, 0.0}, {1.0, 1.0},
+                                {-0.5, 1.0}, {2.0, -3.0}, {0.0, 0.5}};
+    
+    int n = A->rows;
+    double *y0 = (double*)malloc(n * sizeof(double));
+    double *y = (double*)malloc(n * sizeof(double));
+    double *y_ref = (double*)malloc(n * sizeof(double));
+    double *tmp = (double*)malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) y0[i] = (double)rand() / RAND_MAX;
+    
+    printf("   %-16s %7s %12s %12s %8s\n", "method", "cases", "fused(ms)",
+           "Ax+axpby(ms)", "speedup");
+    
+    for (int m = 0; m < 5; m++) {
+        // Every α/β case against α·(Ax) + β·y0
+        int passed = 0;
+        for (int c = 0; c < 6; c++) {
+            double alpha = cases[c][0], beta = cases[c][1];
+            for (int i = 0; i < n; i++) {
+                y_ref[i] = alpha * Ax[i] + beta * y0[i];
+                // β = 0 must ignore y, even NaN
+                y[i] = (beta == 0.0) ? NAN : y0[i];
+            }
+            run_mv(m, alpha, A, B, x, beta, y);
+            passed += (max_abs_diff(y_ref, y, n) < 1e-9);
+        }
+        
+        // General case: fused vs y = A·x into a temporary, then axpby
+        double t_fused = 0.0, t_split = 0.0;
+        for (int rep = 0; rep < 2; rep++) {   // warm-up + timed run
+            memcpy(y, y0, n * sizeof(double));
+            double t = get_time();
+            run_mv(m, 2.0, A, B, x, -3.0, y);
+            t_fused = get_time() - t;
+        }
+        for (int rep = 0; rep < 2; rep++) {
+            memcpy(y, y0, n * sizeof(double));
+            double t = get_time();
+            run_spmv(m, A, B, x, tmp);
+            #pragma omp parallel for
+            for (int i = 0; i < n; i++) y[i] = 2.0 * tmp[i] - 3.0 * y[i];
+            t_split = get_time() - t;
+        }
+        
+        printf("   %-16s   %d/6 %s %10.3f %12.3f %7.2f×\n", names[m], passed,
+               passed == 6 ? "✓" : "✗", t_fused * 1000, t_split * 1000,
+               t_split / t_fused);
+    }
+    printf("\n");
+    
+    free(y0);
+    free(y);
+    free(y_ref);
+    free(tmp);
+}
+
 int main(int argc, char **argv) {
     // Parse arguments
     int n = (argc > 1) ? atoi(argv[1]) : 2000;
@@ -250,6 +1345,26 @@ int main(int argc, char **argv) {
     printf("  • Peak: %.2f GFlop/s\n", roofline);
     printf("  • Best efficiency: %.1f%%\n\n", 100.0 * gflops[best_idx] / roofline);
     
+    // ===== EXTENDED ANALYSIS =====
+    printf("========================================\n");
+    printf("EXTENDED ANALYSIS\n");
+    printf("========================================\n\n");
+    
+    bench_index_width(A_csr, x, y1);
+    bench_csrdu(A_csr, x, y1, n);
+    bench_mixed_precision(A_csr, A_bcsr, x, y1);
+    bench_stream(A_csr, x, y1);
+    bench_partition(A_csr, n);
+    bench_semiring(A_csr, x, y1);
+    bench_spmspv(A_csr);
+    bench_pattern(A_csr, x);
+    bench_dict(A_csr, n);
+    bench_binned(A_csr, n);
+    bench_csr5(A_csr, n);
+    bench_csb(A_csr, n);
+    bench_mpk(A_csr, n);
+    bench_alpha_beta(A_csr, A_bcsr, x, y1);
+    
     printf("========================================\n");
     printf("Next: Generate plots\n");
     printf("Run: python3 plot_results.py\n");
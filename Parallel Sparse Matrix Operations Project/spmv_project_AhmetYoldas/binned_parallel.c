@@ -0,0 +1,184 @@
+/**
+ * Row-Length-Binned SpMV Implementation
+ */
+
+#include "binned_parallel.h"
+#include <omp.h>
+
+Binned_Plan* binned_plan_create(const CSR_Matrix *A) {
+    Binned_Plan *P = (Binned_Plan*)calloc(1, sizeof(Binned_Plan));
+    P->rows = A->rows;
+    
+    // Count bins
+    for (int i = 0; i < A->rows; i++) {
+        int len = A->row_ptr[i + 1] - A->row_ptr[i];
+        if (len <= BIN_SHORT_MAX) {
+            P->num_short++;
+        } else if (len <= BIN_LONG_MIN) {
+            P->num_medium++;
+        } else {
+            P->num_long++;
+            P->num_pieces += (len + BIN_LONG_CHUNK - 1) / BIN_LONG_CHUNK;
+        }
+    }
+    
+    P->num_slices = (P->num_short + BIN_SLICE - 1) / BIN_SLICE;
+    P->slice_rows = (int*)malloc(((size_t)P->num_slices * BIN_SLICE + 1) * sizeof(int));
+    P->slice_ptr = (int*)malloc((P->num_slices + 1) * sizeof(int));
+    P->medium_rows = (int*)malloc((P->num_medium + 1) * sizeof(int));
+    P->long_rows = (int*)malloc((P->num_long + 1) * sizeof(int));
+    P->long_piece_ptr = (int*)malloc((P->num_long + 1) * sizeof(int));
+    P->piece_begin = (int*)malloc((P->num_pieces + 1) * sizeof(int));
+    P->piece_end = (int*)malloc((P->num_pieces + 1) * sizeof(int));
+    P->piece_sum = (double*)malloc((P->num_pieces + 1) * sizeof(double));
+    
+    // Fill row lists (short rows in index order for now)
+    int ns = 0, nm = 0, nl = 0, np = 0;
+    P->long_piece_ptr[0] = 0;
+    for (int i = 0; i < A->rows; i++) {
+        int begin = A->row_ptr[i];
+        int len = A->row_ptr[i + 1] - begin;
+        if (len <= BIN_SHORT_MAX) {
+            P->slice_rows[ns++] = i;
+        } else if (len <= BIN_LONG_MIN) {
+            P->medium_rows[nm++] = i;
+        } else {
+            P->long_rows[nl++] = i;
+            for (int k = 0; k < len; k += BIN_LONG_CHUNK) {
+                P->piece_begin[np] = begin + k;
+                P->piece_end[np] = begin + ((k + BIN_LONG_CHUNK < len) ? k + BIN_LONG_CHUNK : len);
+                np++;
+            }
+            P->long_piece_ptr[nl] = np;
+        }
+    }
+    for (int i = ns; i < P->num_slices * BIN_SLICE; i++) {
+        P->slice_rows[i] = -1;
+    }
+    
+    // Sort short rows by length (longest first) within each σ window:
+    // counting sort, stable, so rows stay near their neighbours in x
+    int *window = (int*)malloc(BIN_SIGMA * sizeof(int));
+    for (int w = 0; w < ns; w += BIN_SIGMA) {
+        int count = (ns - w < BIN_SIGMA) ? ns - w : BIN_SIGMA;
+        int start[BIN_SHORT_MAX + 2] = {0};
+        for (int t = 0; t < count; t++) {
+            int row = P->slice_rows[w + t];
+            int len = A->row_ptr[row + 1] - A->row_ptr[row];
+            start[BIN_SHORT_MAX - len + 1]++;
+        }
+        for (int b = 1; b <= BIN_SHORT_MAX + 1; b++) {
+            start[b] += start[b - 1];
+        }
+        for (int t = 0; t < count; t++) {
+            int row = P->slice_rows[w + t];
+            int len = A->row_ptr[row + 1] - A->row_ptr[row];
+            window[start[BIN_SHORT_MAX - len]++] = row;
+        }
+        memcpy(&P->slice_rows[w], window, count * sizeof(int));
+    }
+    free(window);
+    
+    // Slice widths = longest row in each slice
+    P->slice_ptr[0] = 0;
+    for (int s = 0; s < P->num_slices; s++) {
+        int width = 0;
+        for (int l = 0; l < BIN_SLICE; l++) {
+            int row = P->slice_rows[s * BIN_SLICE + l];
+            if (row >= 0) {
+                int len = A->row_ptr[row + 1] - A->row_ptr[row];
+                if (len > width) width = len;
+            }
+        }
+        P->slice_ptr[s + 1] = P->slice_ptr[s] + width * BIN_SLICE;
+    }
+    
+    // Column-major copy of the short rows, zero padded
+    size_t slice_nnz = (size_t)P->slice_ptr[P->num_slices];
+    P->slice_col = (int*)calloc(slice_nnz + 1, sizeof(int));
+    P->slice_val = (double*)calloc(slice_nnz + 1, sizeof(double));
+    for (int s = 0; s < P->num_slices; s++) {
+        for (int l = 0; l < BIN_SLICE; l++) {
+            int row = P->slice_rows[s * BIN_SLICE + l];
+            if (row < 0) continue;
+            for (int k = A->row_ptr[row]; k < A->row_ptr[row + 1]; k++) {
+                size_t pos = P->slice_ptr[s] + (size_t)(k - A->row_ptr[row]) * BIN_SLICE + l;
+                P->slice_col[pos] = A->col_idx[k];
+                P->slice_val[pos] = A->values[k];
+            }
+        }
+    }
+    
+    return P;
+}
+
+void binned_plan_free(Binned_Plan *P) {
+    if (P) {
+        free(P->slice_rows);
+        free(P->slice_ptr);
+        free(P->slice_col);
+        free(P->slice_val);
+        free(P->medium_rows);
+        free(P->long_rows);
+        free(P->long_piece_ptr);
+        free(P->piece_begin);
+        free(P->piece_end);
+        free(P->piece_sum);
+        free(P);
+    }
+}
+
+void spmv_binned_parallel(const CSR_Matrix *A, Binned_Plan *P, const double *x, double *y) {
+    #pragma omp parallel
+    {
+        // 1. Long-row pieces first: largest tasks
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (int p = 0; p < P->num_pieces; p++) {
+            double sum = 0.0;
+            for (int k = P->piece_begin[p]; k < P->piece_end[p]; k++) {
+                sum += A->values[k] * x[A->col_idx[k]];
+            }
+            P->piece_sum[p] = sum;
+        }
+        
+        // 2. Short-row slices: one row per SIMD lane
+        #pragma omp for schedule(dynamic, 16) nowait
+        for (int s = 0; s < P->num_slices; s++) {
+            double acc[BIN_SLICE] = {0.0};
+            for (int k = P->slice_ptr[s]; k < P->slice_ptr[s + 1]; k += BIN_SLICE) {
+                const int *col = &P->slice_col[k];
+                const double *val = &P->slice_val[k];
+                #pragma omp simd
+                for (int l = 0; l < BIN_SLICE; l++) {
+                    acc[l] += val[l] * x[col[l]];
+                }
+            }
+            const int *rows = &P->slice_rows[s * BIN_SLICE];
+            for (int l = 0; l < BIN_SLICE; l++) {
+                if (rows[l] >= 0) y[rows[l]] = acc[l];
+            }
+        }
+        
+        // 3. Medium rows: one row per iteration (the barrier at the end
+        //    also waits for every long-row piece)
+        #pragma omp for schedule(dynamic, 64)
+        for (int m = 0; m < P->num_medium; m++) {
+            int i = P->medium_rows[m];
+            double sum = 0.0;
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                sum += A->values[k] * x[A->col_idx[k]];
+            }
+            y[i] = sum;
+        }
+        
+        // 4. Reduce long-row pieces (in piece order)
+        #pragma omp for schedule(static)
+        for (int r = 0; r < P->num_long; r++) {
+            double sum = 0.0;
+            for (int p = P->long_piece_ptr[r]; p < P->long_piece_ptr[r + 1]; p++) {
+                sum += P->piece_sum[p];
+            }
+            y[P->long_rows[r]] = sum;
+        }
+    }
+}
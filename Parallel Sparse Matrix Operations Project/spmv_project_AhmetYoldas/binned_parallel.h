@@ -0,0 +1,71 @@
+/**
+ * Row-Length-Binned SpMV
+ * Hybrid scheduler: short / medium / long rows
+ */
+
+#ifndef BINNED_PARALLEL_H
+#define BINNED_PARALLEL_H
+
+#include "common.h"
+
+#define BIN_SHORT_MAX   8      // ≤ this many nnz: SIMD slice path
+#define BIN_SLICE       8      // Rows per SIMD slice (one lane per row)
+#define BIN_SIGMA       256    // Short rows sorted by length within windows of σ rows
+#define BIN_LONG_MIN    1024   // > this many nnz: row split across threads
+#define BIN_LONG_CHUNK  512    // nnz per piece of a split row
+
+// Preprocessed row bins for one matrix (built once, reused per SpMV)
+typedef struct {
+    int rows;
+    
+    // Short rows: SELL-8-σ slices, column-major within a slice, rows
+    // padded to the slice's longest row (col 0, value 0)
+    int num_short;
+    int num_slices;
+    int *slice_rows;      // Size: num_slices × BIN_SLICE (-1 = empty lane)
+    int *slice_ptr;       // Size: num_slices+1, offsets into slice_col/val
+    int *slice_col;
+    double *slice_val;
+    
+    // Medium rows: one row per iteration
+    int num_medium;
+    int *medium_rows;
+    
+    // Long rows: split into pieces, reduced at the end of the parallel region
+    int num_long;
+    int *long_rows;       // Size: num_long
+    int *long_piece_ptr;  // Size: num_long+1, pieces of each long row
+    int num_pieces;
+    int *piece_begin;     // Size: num_pieces, nnz range [begin, end)
+    int *piece_end;
+    double *piece_sum;    // Size: num_pieces, partial sums (scratch)
+} Binned_Plan;
+
+// Bin the rows of A by length (O(nnz) for the short-row copy)
+Binned_Plan* binned_plan_create(const CSR_Matrix *A);
+void binned_plan_free(Binned_Plan *P);
+
+/**
+ * Binned SpMV: y = A·x using a plan from binned_plan_create(A)
+ * 
+ * Position-based buckets (Method 4) run every row through the same
+ * scalar loop, so heavy-tailed matrices get idle SIMD lanes on short
+ * rows and one thread stuck on a dense row. Here, in one parallel
+ * region:
+ * 
+ * 1. Long-row pieces (dynamic, 1): any thread can take a piece of a
+ *    dense row
+ * 2. Short-row slices (dynamic): 8 rows advance together, one per
+ *    SIMD lane, over the padded slice. Within each window of σ short
+ *    rows, rows are sorted by length so a slice holds rows of (nearly)
+ *    equal length and little padding
+ * 3. Medium rows (dynamic, 64): plain CSR row loop
+ * 4. Long rows (static): sum of their pieces, after the barrier that
+ *    ends step 3
+ * 
+ * Long pieces are scheduled first so the biggest tasks never end up
+ * last on one thread.
+ */
+void spmv_binned_parallel(const CSR_Matrix *A, Binned_Plan *P, const double *x, double *y);
+
+#endif // BINNED_PARALLEL_H
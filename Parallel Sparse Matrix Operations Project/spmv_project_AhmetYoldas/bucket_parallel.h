@@ -30,4 +30,13 @@
  */
 void spmv_bucket_parallel(const CSR_Matrix *A, const double *x, double *y);
 
+/**
+ * CSR+Bucket Parallel y = α·A·x + β·y
+ * 
+ * Same adaptive buckets; each row is scaled and merged with y as it
+ * is finished, while y[bucket] is still in L2.
+ */
+void spmv_bucket_parallel_mv(double alpha, const CSR_Matrix *A, const double *x,
+                             double beta, double *y);
+
 #endif // BUCKET_PARALLEL_H
@@ -3,6 +3,9 @@
  */
 
 #include "common.h"
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // ============================================
 // CSR Memory Management
@@ -29,8 +32,11 @@ void csr_free(CSR_Matrix *A) {
 }
 
 CSR_Matrix* csr_random(int n, double density) {
-    int nnz_estimate = (int)(n * n * density * 1.2);
-    CSR_Matrix *A = csr_alloc(n, n, nnz_estimate);
+    // int64_t: n²·density passes 2³¹ well before n does; a 32-bit
+    // CSR_Matrix holds at most INT_MAX entries (see CSR64_Matrix)
+    int64_t nnz_estimate = (int64_t)((double)n * n * density * 1.2);
+    if (nnz_estimate > INT32_MAX) nnz_estimate = INT32_MAX;
+    CSR_Matrix *A = csr_alloc(n, n, (int)nnz_estimate);
     
     int nnz_actual = 0;
     A->row_ptr[0] = 0;
@@ -52,6 +58,623 @@ CSR_Matrix* csr_random(int n, double density) {
     return A;
 }
 
+CSR_Matrix* csr_laplacian_2d(int nx, int ny) {
+    int n = nx * ny;
+    CSR_Matrix *A = csr_alloc(n, n, 5 * n);
+    
+    int k = 0;
+    for (int iy = 0; iy < ny; iy++) {
+        for (int ix = 0; ix < nx; ix++) {
+            int row = iy * nx + ix;
+            // Columns in ascending order
+            if (iy > 0)      { A->col_idx[k] = row - nx; A->values[k++] = -1.0; }
+            if (ix > 0)      { A->col_idx[k] = row - 1;  A->values[k++] = -1.0; }
+            A->col_idx[k] = row; A->values[k++] = 4.0;
+            if (ix < nx - 1) { A->col_idx[k] = row + 1;  A->values[k++] = -1.0; }
+            if (iy < ny - 1) { A->col_idx[k] = row + nx; A->values[k++] = -1.0; }
+            A->row_ptr[row + 1] = k;
+        }
+    }
+    
+    A->nnz = k;
+    return A;
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int ia = *(const int*)a, ib = *(const int*)b;
+    return (ia > ib) - (ia < ib);
+}
+
+CSR_Matrix* csr_power_law(int n, int avg_nnz) {
+    // Pareto(alpha) row lengths: most rows short, a few dense rows
+    const double alpha = 1.2;
+    double xm = avg_nnz * (alpha - 1.0) / alpha;
+    if (xm < 1.0) xm = 1.0;
+    
+    int *len = (int*)malloc(n * sizeof(int));
+    long long total = 0;
+    for (int i = 0; i < n; i++) {
+        double u = ((double)rand() + 1.0) / ((double)RAND_MAX + 1.0);
+        double l = ceil(xm * pow(u, -1.0 / alpha));
+        len[i] = (l > n) ? n : (int)l;
+        total += len[i];
+    }
+    
+    CSR_Matrix *A = csr_alloc(n, n, (int)total);
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        int start = k;
+        if (len[i] > n / 8) {
+            // Dense row: selection sampling, exactly len[i] sorted columns
+            for (int j = 0; j < n && k - start < len[i]; j++) {
+                double u = (double)rand() / ((double)RAND_MAX + 1.0);
+                if (u * (n - j) < len[i] - (k - start)) A->col_idx[k++] = j;
+            }
+        } else {
+            // Sparse row: sample, sort, drop duplicates
+            for (int e = 0; e < len[i]; e++) A->col_idx[start + e] = rand() % n;
+            qsort(&A->col_idx[start], len[i], sizeof(int), cmp_int);
+            k = start;
+            for (int e = 0; e < len[i]; e++) {
+                if (k == start || A->col_idx[k - 1] != A->col_idx[start + e]) {
+                    A->col_idx[k++] = A->col_idx[start + e];
+                }
+            }
+        }
+        for (int e = start; e < k; e++) A->values[e] = (double)rand() / RAND_MAX;
+        A->row_ptr[i + 1] = k;
+    }
+    
+    A->nnz = k;
+    free(len);
+    return A;
+}
+
+CSR_Matrix* csr_permute(const CSR_Matrix *A, const int *perm) {
+    CSR_Matrix *B = csr_alloc(A->rows, A->cols, A->nnz);
+    int *inv = (int*)malloc(A->rows * sizeof(int));
+    for (int i = 0; i < A->rows; i++) {
+        inv[perm[i]] = i;
+    }
+    
+    int k = 0;
+    for (int i = 0; i < A->rows; i++) {
+        int old = perm[i];
+        int start = k;
+        for (int kk = A->row_ptr[old]; kk < A->row_ptr[old + 1]; kk++) {
+            // Insertion sort keeps columns ascending in the new numbering
+            int col = inv[A->col_idx[kk]];
+            double val = A->values[kk];
+            int pos = k++;
+            while (pos > start && B->col_idx[pos - 1] > col) {
+                B->col_idx[pos] = B->col_idx[pos - 1];
+                B->values[pos] = B->values[pos - 1];
+                pos--;
+            }
+            B->col_idx[pos] = col;
+            B->values[pos] = val;
+        }
+        B->row_ptr[i + 1] = k;
+    }
+    
+    free(inv);
+    return B;
+}
+
+// ============================================
+// Pattern-Only Conversion
+// ============================================
+
+int csr_is_uniform(const CSR_Matrix *A, double *value) {
+    double v = (A->nnz > 0) ? A->values[0] : 1.0;
+    for (int k = 1; k < A->nnz; k++) {
+        if (A->values[k] != v) return 0;
+    }
+    if (value) *value = v;
+    return 1;
+}
+
+CSR_Pattern_Matrix* csr_to_pattern(const CSR_Matrix *A) {
+    double value;
+    if (!csr_is_uniform(A, &value)) return NULL;
+    
+    CSR_Pattern_Matrix *P = (CSR_Pattern_Matrix*)malloc(sizeof(CSR_Pattern_Matrix));
+    P->rows = A->rows;
+    P->cols = A->cols;
+    P->nnz = A->nnz;
+    P->value = value;
+    P->row_ptr = (int*)malloc((A->rows + 1) * sizeof(int));
+    P->col_idx = (int*)malloc((size_t)A->nnz * sizeof(int));
+    
+    memcpy(P->row_ptr, A->row_ptr, (A->rows + 1) * sizeof(int));
+    memcpy(P->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    return P;
+}
+
+void csr_pattern_free(CSR_Pattern_Matrix *A) {
+    if (A) {
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A);
+    }
+}
+
+BCSR_Pattern_Matrix* csr_to_bcsr_pattern(const CSR_Matrix *A) {
+    double value;
+    if (!csr_is_uniform(A, &value)) return NULL;
+    
+    // Reuse the BCSR block structure, then turn each block into a mask
+    BCSR_Matrix *B = csr_to_bcsr(A);
+    BCSR_Pattern_Matrix *P = (BCSR_Pattern_Matrix*)malloc(sizeof(BCSR_Pattern_Matrix));
+    
+    P->rows = B->rows;
+    P->cols = B->cols;
+    P->block_rows = B->block_rows;
+    P->block_cols = B->block_cols;
+    P->num_blocks = B->num_blocks;
+    P->value = value;
+    P->block_row_ptr = B->block_row_ptr;
+    P->block_col_idx = B->block_col_idx;
+    P->block_mask = (uint16_t*)calloc((size_t)B->num_blocks + 1, sizeof(uint16_t));
+    
+    // Mark positions from the CSR pattern (explicit entries, even zeros)
+    int *col_map = (int*)malloc(B->block_cols * sizeof(int));
+    for (int br = 0; br < B->block_rows; br++) {
+        for (int kb = B->block_row_ptr[br]; kb < B->block_row_ptr[br + 1]; kb++) {
+            col_map[B->block_col_idx[kb]] = kb;
+        }
+        
+        for (int i = 0; i < 4 && (br * 4 + i) < A->rows; i++) {
+            int row = br * 4 + i;
+            for (int k = A->row_ptr[row]; k < A->row_ptr[row + 1]; k++) {
+                int col = A->col_idx[k];
+                P->block_mask[col_map[col / 4]] |= (uint16_t)(1u << (i * 4 + col % 4));
+            }
+        }
+    }
+    free(col_map);
+    
+    free(B->block_val);
+    free(B);
+    return P;
+}
+
+void bcsr_pattern_free(BCSR_Pattern_Matrix *A) {
+    if (A) {
+        free(A->block_row_ptr);
+        free(A->block_col_idx);
+        free(A->block_mask);
+        free(A);
+    }
+}
+
+// ============================================
+// CSR5 Tiles
+// ============================================
+
+CSR5_Matrix* csr_to_csr5(const CSR_Matrix *A) {
+    CSR5_Matrix *B = (CSR5_Matrix*)malloc(sizeof(CSR5_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    B->num_tiles = (A->nnz + CSR5_TILE - 1) / CSR5_TILE;
+    B->col_idx = (int*)malloc(((size_t)A->nnz + 1) * sizeof(int));
+    B->values = (double*)malloc(((size_t)A->nnz + 1) * sizeof(double));
+    B->tile_row = (int*)malloc((B->num_tiles + 1) * sizeof(int));
+    B->tile_mask = (uint64_t*)calloc(B->num_tiles + 1, sizeof(uint64_t));
+    B->nz_rows = NULL;
+    
+    // Full tiles: lane-major (CSR) → step-major; the tail stays in CSR order
+    int full = A->nnz / CSR5_TILE;
+    for (int t = 0; t < full; t++) {
+        size_t base = (size_t)t * CSR5_TILE;
+        for (int l = 0; l < CSR5_OMEGA; l++) {
+            for (int p = 0; p < CSR5_SIGMA; p++) {
+                B->col_idx[base + p * CSR5_OMEGA + l] = A->col_idx[base + l * CSR5_SIGMA + p];
+                B->values[base + p * CSR5_OMEGA + l] = A->values[base + l * CSR5_SIGMA + p];
+            }
+        }
+    }
+    for (size_t k = (size_t)full * CSR5_TILE; k < (size_t)A->nnz; k++) {
+        B->col_idx[k] = A->col_idx[k];
+        B->values[k] = A->values[k];
+    }
+    
+    int num_nonempty = 0;
+    for (int i = 0; i < A->rows; i++) {
+        if (A->row_ptr[i + 1] > A->row_ptr[i]) num_nonempty++;
+    }
+    if (num_nonempty < A->rows) {
+        B->nz_rows = (int*)malloc(num_nonempty * sizeof(int));
+    }
+    
+    // One pass over rows: row-start bits, and the row owning each
+    // tile's first entry
+    int ord = 0;
+    for (int i = 0; i < A->rows; i++) {
+        int start = A->row_ptr[i];
+        int end = A->row_ptr[i + 1];
+        if (end == start) continue;
+        
+        B->tile_mask[start / CSR5_TILE] |= 1ULL << (start % CSR5_TILE);
+        for (int t = (start + CSR5_TILE - 1) / CSR5_TILE; t * CSR5_TILE < end; t++) {
+            B->tile_row[t] = ord;
+        }
+        if (B->nz_rows) B->nz_rows[ord] = i;
+        ord++;
+    }
+    
+    return B;
+}
+
+void csr5_free(CSR5_Matrix *A) {
+    if (A) {
+        free(A->col_idx);
+        free(A->values);
+        free(A->tile_row);
+        free(A->tile_mask);
+        free(A->nz_rows);
+        free(A);
+    }
+}
+
+// ============================================
+// CSC Conversion
+// ============================================
+
+CSC_Matrix* csr_to_csc(const CSR_Matrix *A) {
+    CSC_Matrix *B = (CSC_Matrix*)malloc(sizeof(CSC_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    B->col_ptr = (int*)calloc(A->cols + 1, sizeof(int));
+    B->row_idx = (int*)malloc((size_t)A->nnz * sizeof(int));
+    B->values = (double*)malloc((size_t)A->nnz * sizeof(double));
+    
+    // Count entries per column
+    for (int k = 0; k < A->nnz; k++) {
+        B->col_ptr[A->col_idx[k] + 1]++;
+    }
+    for (int j = 0; j < A->cols; j++) {
+        B->col_ptr[j + 1] += B->col_ptr[j];
+    }
+    
+    // Scatter rows in ascending order
+    int *fill = (int*)malloc((A->cols + 1) * sizeof(int));
+    memcpy(fill, B->col_ptr, (A->cols + 1) * sizeof(int));
+    for (int i = 0; i < A->rows; i++) {
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            int pos = fill[A->col_idx[k]]++;
+            B->row_idx[pos] = i;
+            B->values[pos] = A->values[k];
+        }
+    }
+    
+    free(fill);
+    return B;
+}
+
+void csc_free(CSC_Matrix *A) {
+    if (A) {
+        free(A->col_ptr);
+        free(A->row_idx);
+        free(A->values);
+        free(A);
+    }
+}
+
+// ============================================
+// CSB Conversion
+// ============================================
+
+// Spread the low 16 bits of v to the even bit positions
+static inline uint32_t csb_spread16(uint32_t v) {
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+CSB_Matrix* csr_to_csb(const CSR_Matrix *A) {
+    CSB_Matrix *B = (CSB_Matrix*)malloc(sizeof(CSB_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    
+    // β = power of two near √max(rows, cols), grown until the blocks
+    // hold ~CSB_BLOCK_NNZ entries on average: tiny blocks make blk_ptr
+    // the bigger stream, and the column-order walk of Aᵀ·x misses on it
+    int n = (A->rows > A->cols) ? A->rows : A->cols;
+    B->lg_beta = 0;
+    while ((1LL << (2 * (B->lg_beta + 1))) <= n) B->lg_beta++;
+    if (B->lg_beta < 4) B->lg_beta = 4;
+    while (B->lg_beta < 16) {
+        double blocks = ceil((double)A->rows / (1 << B->lg_beta)) *
+                        ceil((double)A->cols / (1 << B->lg_beta));
+        if ((double)A->nnz / blocks >= CSB_BLOCK_NNZ) break;
+        B->lg_beta++;
+    }
+    while ((1 << B->lg_beta) > CSB_MAX_BETA) B->lg_beta--;
+    B->beta = 1 << B->lg_beta;
+    
+    B->block_rows = (A->rows + B->beta - 1) >> B->lg_beta;
+    B->block_cols = (A->cols + B->beta - 1) >> B->lg_beta;
+    size_t num_blocks = (size_t)B->block_rows * B->block_cols;
+    
+    B->blk_ptr = (int*)calloc(num_blocks + 1, sizeof(int));
+    B->idx = (uint32_t*)malloc((size_t)A->nnz * sizeof(uint32_t));
+    B->values = (double*)malloc((size_t)A->nnz * sizeof(double));
+    
+    // Count entries per block
+    for (int i = 0; i < A->rows; i++) {
+        size_t row_base = (size_t)(i >> B->lg_beta) * B->block_cols;
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            B->blk_ptr[row_base + (A->col_idx[k] >> B->lg_beta) + 1]++;
+        }
+    }
+    int max_block = 0;
+    for (size_t b = 0; b < num_blocks; b++) {
+        if (B->blk_ptr[b + 1] > max_block) max_block = B->blk_ptr[b + 1];
+        B->blk_ptr[b + 1] += B->blk_ptr[b];
+    }
+    
+    // Fill in row order: entries are row-major inside each block here
+    int *next = (int*)malloc(num_blocks * sizeof(int));
+    memcpy(next, B->blk_ptr, num_blocks * sizeof(int));
+    uint32_t mask = (uint32_t)B->beta - 1;
+    for (int i = 0; i < A->rows; i++) {
+        size_t row_base = (size_t)(i >> B->lg_beta) * B->block_cols;
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            int col = A->col_idx[k];
+            int pos = next[row_base + (col >> B->lg_beta)]++;
+            B->idx[pos] = (((uint32_t)i & mask) << 16) | ((uint32_t)col & mask);
+            B->values[pos] = A->values[k];
+        }
+    }
+    free(next);
+    
+    // Reorder each block along the Z-Morton curve of (row, col), so
+    // both directions walk x and y with the same locality. Sort keys
+    // are (morton << 32) | offset in the block
+    uint64_t *key = (uint64_t*)malloc(((size_t)max_block + 1) * sizeof(uint64_t));
+    uint32_t *tmp_idx = (uint32_t*)malloc(((size_t)max_block + 1) * sizeof(uint32_t));
+    double *tmp_val = (double*)malloc(((size_t)max_block + 1) * sizeof(double));
+    for (size_t b = 0; b < num_blocks; b++) {
+        int begin = B->blk_ptr[b];
+        int len = B->blk_ptr[b + 1] - begin;
+        if (len < 2) continue;
+        for (int e = 0; e < len; e++) {
+            uint32_t ij = B->idx[begin + e];
+            uint32_t z = (csb_spread16(ij >> 16) << 1) | csb_spread16(ij & 0xFFFFu);
+            key[e] = ((uint64_t)z << 32) | (uint32_t)e;
+        }
+        qsort(key, len, sizeof(uint64_t), cmp_u64);
+        for (int e = 0; e < len; e++) {
+            int from = begin + (int)(key[e] & 0xFFFFFFFFu);
+            tmp_idx[e] = B->idx[from];
+            tmp_val[e] = B->values[from];
+        }
+        memcpy(&B->idx[begin], tmp_idx, len * sizeof(uint32_t));
+        memcpy(&B->values[begin], tmp_val, len * sizeof(double));
+    }
+    free(key);
+    free(tmp_idx);
+    free(tmp_val);
+    
+    return B;
+}
+
+void csb_free(CSB_Matrix *A) {
+    if (A) {
+        free(A->blk_ptr);
+        free(A->idx);
+        free(A->values);
+        free(A);
+    }
+}
+
+// ============================================
+// CSR (64-bit row_ptr) Memory Management
+// ============================================
+
+CSR64_Matrix* csr64_alloc(int rows, int cols, int64_t nnz) {
+    CSR64_Matrix *A = (CSR64_Matrix*)malloc(sizeof(CSR64_Matrix));
+    if (!A) return NULL;
+    A->rows = rows;
+    A->cols = cols;
+    A->nnz = nnz;
+    A->row_ptr = (int64_t*)calloc((size_t)rows + 1, sizeof(int64_t));
+    A->col_idx = (int*)malloc((size_t)nnz * sizeof(int) + 1);
+    A->values = (double*)malloc((size_t)nnz * sizeof(double) + 1);
+    if (!A->row_ptr || !A->col_idx || !A->values) {
+        csr64_free(A);
+        return NULL;
+    }
+    return A;
+}
+
+void csr64_free(CSR64_Matrix *A) {
+    if (A) {
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A->values);
+        free(A);
+    }
+}
+
+CSR64_Matrix* csr_to_csr64(const CSR_Matrix *A) {
+    CSR64_Matrix *B = csr64_alloc(A->rows, A->cols, A->nnz);
+    if (!B) return NULL;
+    
+    for (int i = 0; i <= A->rows; i++) {
+        B->row_ptr[i] = A->row_ptr[i];
+    }
+    memcpy(B->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    memcpy(B->values, A->values, (size_t)A->nnz * sizeof(double));
+    
+    return B;
+}
+
+// ============================================
+// CSR-DU Conversion
+// ============================================
+
+// Width class needed to store one column delta
+static int csrdu_width(unsigned int delta) {
+    if (delta <= 0xFF) return CSRDU_U8;
+    if (delta <= 0xFFFF) return CSRDU_U16;
+    return CSRDU_U32;
+}
+
+static const int csrdu_unit_bytes[3] = {1, 2, 4};
+#define CSRDU_UNIT_COST 4   // Header byte + ~3 bytes' worth of decode overhead
+
+// Encode one row into out (or only count bytes if out == NULL); the
+// first delta is taken from base. Units are chosen by a shortest-path
+// pass over the row: cost = payload bytes + CSRDU_UNIT_COST per unit,
+// so one wide delta gets its own unit instead of widening its
+// neighbours, but runs are not cut into many short units (each unit
+// is a branch and a masked step in the decoder). best/next/unit_width
+// are scratch of len+1 ints.
+static int csrdu_encode_row(const int *cols, int len, int base, uint8_t *out,
+                            int *best, int *next, int *unit_width) {
+    best[len] = 0;
+    for (int k = len - 1; k >= 0; k--) {
+        best[k] = INT32_MAX;
+        int width = CSRDU_U8;
+        int prev = (k == 0) ? base : cols[k - 1];
+        for (int count = 1; count <= CSRDU_MAX_UNIT && k + count <= len; count++) {
+            int w = csrdu_width((unsigned int)(cols[k + count - 1] - prev));
+            if (w > width) width = w;
+            prev = cols[k + count - 1];
+            int cost = CSRDU_UNIT_COST + count * csrdu_unit_bytes[width] + best[k + count];
+            if (cost <= best[k]) {
+                best[k] = cost;
+                next[k] = k + count;
+                unit_width[k] = width;
+            }
+        }
+    }
+    
+    int pos = 0;
+    int prev = base;
+    for (int k = 0; k < len; k = next[k]) {
+        int width = unit_width[k];
+        int count = next[k] - k;
+        if (out) out[pos] = (uint8_t)(width | ((count - 1) << 2) | (k == 0 ? CSRDU_NEW_ROW : 0));
+        pos++;
+        for (int j = k; j < next[k]; j++) {
+            unsigned int delta = (unsigned int)(cols[j] - prev);
+            prev = cols[j];
+            if (!out) {
+                // Size only
+            } else if (width == CSRDU_U8) {
+                out[pos] = (uint8_t)delta;
+            } else if (width == CSRDU_U16) {
+                uint16_t d = (uint16_t)delta;
+                memcpy(out + pos, &d, sizeof(d));
+            } else {
+                uint32_t d = (uint32_t)delta;
+                memcpy(out + pos, &d, sizeof(d));
+            }
+            pos += csrdu_unit_bytes[width];
+        }
+    }
+    return pos;
+}
+
+// Encode rows [begin, end) into out (or only count bytes if out == NULL)
+static int csrdu_encode_group(const CSR_Matrix *A, int begin, int end, uint8_t *out,
+                              int *best, int *next, int *unit_width) {
+    int pos = 0;
+    int base = 0;
+    for (int i = begin; i < end; ) {
+        int start = A->row_ptr[i];
+        int len = A->row_ptr[i + 1] - start;
+        if (len == 0) {
+            // Run of empty rows, CSRDU_MAX_UNIT per unit
+            int run = 0;
+            while (i < end && run < CSRDU_MAX_UNIT && A->row_ptr[i + 1] == A->row_ptr[i]) {
+                run++;
+                i++;
+            }
+            if (out) out[pos] = (uint8_t)(CSRDU_EMPTY | ((run - 1) << 2) | CSRDU_NEW_ROW);
+            pos++;
+            continue;
+        }
+        pos += csrdu_encode_row(&A->col_idx[start], len, base, out ? out + pos : NULL,
+                                best, next, unit_width);
+        base = A->col_idx[start];
+        i++;
+    }
+    return pos;
+}
+
+CSRDU_Matrix* csr_to_csrdu(const CSR_Matrix *A) {
+    CSRDU_Matrix *B = (CSRDU_Matrix*)malloc(sizeof(CSRDU_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    B->num_groups = (A->rows + CSRDU_GROUP - 1) / CSRDU_GROUP;
+    B->grp_val = (int*)malloc((B->num_groups + 1) * sizeof(int));
+    B->grp_ctl = (int*)malloc((B->num_groups + 1) * sizeof(int));
+    B->values = (double*)malloc((size_t)A->nnz * sizeof(double));
+    memcpy(B->values, A->values, (size_t)A->nnz * sizeof(double));
+    
+    int max_len = 0;
+    for (int i = 0; i < A->rows; i++) {
+        int len = A->row_ptr[i + 1] - A->row_ptr[i];
+        if (len > max_len) max_len = len;
+    }
+    int *best = (int*)malloc((max_len + 1) * sizeof(int));
+    int *next = (int*)malloc((max_len + 1) * sizeof(int));
+    int *unit_width = (int*)malloc((max_len + 1) * sizeof(int));
+    
+    // Pass 1: size of each group's unit stream
+    B->grp_ctl[0] = 0;
+    for (int g = 0; g < B->num_groups; g++) {
+        int begin = g * CSRDU_GROUP;
+        int end = (begin + CSRDU_GROUP < A->rows) ? begin + CSRDU_GROUP : A->rows;
+        B->grp_val[g] = A->row_ptr[begin];
+        B->grp_ctl[g + 1] = B->grp_ctl[g] +
+                            csrdu_encode_group(A, begin, end, NULL, best, next, unit_width);
+    }
+    B->grp_val[B->num_groups] = A->nnz;
+    
+    // Pass 2: encode
+    B->ctl = (uint8_t*)calloc((size_t)B->grp_ctl[B->num_groups] + CSRDU_PAD, 1);
+    for (int g = 0; g < B->num_groups; g++) {
+        int begin = g * CSRDU_GROUP;
+        int end = (begin + CSRDU_GROUP < A->rows) ? begin + CSRDU_GROUP : A->rows;
+        csrdu_encode_group(A, begin, end, B->ctl + B->grp_ctl[g], best, next, unit_width);
+    }
+    
+    free(best);
+    free(next);
+    free(unit_width);
+    return B;
+}
+
+void csrdu_free(CSRDU_Matrix *A) {
+    if (A) {
+        free(A->grp_val);
+        free(A->grp_ctl);
+        free(A->ctl);
+        free(A->values);
+        free(A);
+    }
+}
+
 // ============================================
 // BCSR Conversion
 // ============================================
@@ -93,7 +716,7 @@ BCSR_Matrix* csr_to_bcsr(const CSR_Matrix *A) {
     
     B->block_row_ptr = (int*)malloc((B->block_rows + 1) * sizeof(int));
     B->block_col_idx = (int*)malloc(B->num_blocks * sizeof(int));
-    B->block_val = (double*)calloc(B->num_blocks * 16, sizeof(double));
+    B->block_val = (double*)calloc((size_t)B->num_blocks * 16, sizeof(double));
     
     B->block_row_ptr[0] = 0;
     for (int br = 0; br < B->block_rows; br++) {
@@ -123,7 +746,7 @@ BCSR_Matrix* csr_to_bcsr(const CSR_Matrix *A) {
                 }
                 
                 int bidx = col_map[bc];
-                B->block_val[bidx * 16 + i * 4 + j] = A->values[k];
+                B->block_val[(size_t)bidx * 16 + i * 4 + j] = A->values[k];
             }
         }
         free(col_map);
@@ -141,3 +764,400 @@ void bcsr_free(BCSR_Matrix *A) {
         free(A);
     }
 }
+
+// ============================================
+// Binary CSR File I/O
+// ============================================
+
+// pwrite() until all bytes are out (returns 0 on success)
+static int write_full(int fd, const void *buf, size_t bytes, int64_t offset) {
+    const char *p = (const char*)buf;
+    while (bytes > 0) {
+        ssize_t n = pwrite(fd, p, bytes, (off_t)offset);
+        if (n <= 0) return -1;
+        p += n;
+        bytes -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+// pread() until all bytes are in (returns 0 on success)
+static int read_full(int fd, void *buf, size_t bytes, int64_t offset) {
+    char *p = (char*)buf;
+    while (bytes > 0) {
+        ssize_t n = pread(fd, p, bytes, (off_t)offset);
+        if (n <= 0) return -1;
+        p += n;
+        bytes -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+CSR_File_Writer* csr_file_writer_open(const char *path, int rows, int cols, int64_t nnz) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Error: Could not create %s\n", path);
+        return NULL;
+    }
+    
+    CSR_File_Writer *W = (CSR_File_Writer*)malloc(sizeof(CSR_File_Writer));
+    if (!W) {
+        close(fd);
+        return NULL;
+    }
+    W->fd = fd;
+    W->rows = rows;
+    W->cols = cols;
+    W->nnz = nnz;
+    W->rows_written = 0;
+    W->nnz_written = 0;
+    W->col_offset = 8 + 3 * (int64_t)sizeof(int64_t) + ((int64_t)rows + 1) * (int64_t)sizeof(int64_t);
+    W->val_offset = W->col_offset + nnz * (int64_t)sizeof(int);
+    
+    // Header and row_ptr[0]; each append fills in its own row_ptr entries
+    int64_t header[4] = {rows, cols, nnz, 0};
+    W->error = write_full(fd, CSR_FILE_MAGIC, 8, 0) ||
+               write_full(fd, header, sizeof(header), 8);
+    return W;
+}
+
+int csr_file_writer_append(CSR_File_Writer *W, const CSR_Matrix *panel) {
+    if (W->error) return -1;
+    if (W->rows_written + (int64_t)panel->rows > W->rows ||
+        W->nnz_written + panel->nnz > W->nnz) {
+        printf("Error: Panel exceeds the declared %d rows / %lld nonzeros\n",
+               W->rows, (long long)W->nnz);
+        W->error = 1;
+        return -1;
+    }
+    
+    int64_t *row_ptr = (int64_t*)malloc(((size_t)panel->rows + 1) * sizeof(int64_t));
+    if (!row_ptr) {
+        W->error = 1;
+        return -1;
+    }
+    for (int i = 1; i <= panel->rows; i++) {
+        row_ptr[i - 1] = W->nnz_written + panel->row_ptr[i];
+    }
+    
+    int64_t ptr_offset = 8 + 3 * (int64_t)sizeof(int64_t) +
+                         ((int64_t)W->rows_written + 1) * (int64_t)sizeof(int64_t);
+    W->error = write_full(W->fd, row_ptr, (size_t)panel->rows * sizeof(int64_t), ptr_offset) ||
+               write_full(W->fd, panel->col_idx, (size_t)panel->nnz * sizeof(int),
+                          W->col_offset + W->nnz_written * (int64_t)sizeof(int)) ||
+               write_full(W->fd, panel->values, (size_t)panel->nnz * sizeof(double),
+                          W->val_offset + W->nnz_written * (int64_t)sizeof(double));
+    free(row_ptr);
+    
+    W->rows_written += panel->rows;
+    W->nnz_written += panel->nnz;
+    return W->error ? -1 : 0;
+}
+
+int csr_file_writer_close(CSR_File_Writer *W) {
+    int err = W->error;
+    if (!err && (W->rows_written != W->rows || W->nnz_written != W->nnz)) {
+        printf("Error: Binary CSR file incomplete (%d of %d rows, %lld of %lld nonzeros)\n",
+               W->rows_written, W->rows, (long long)W->nnz_written, (long long)W->nnz);
+        err = 1;
+    }
+    
+    // Flush so the file can be evicted from the page cache later
+    if (!err) err = fsync(W->fd);
+    if (close(W->fd) != 0) err = 1;
+    
+    free(W);
+    return err ? -1 : 0;
+}
+
+int csr_write_binary(const CSR_Matrix *A, const char *path) {
+    CSR_File_Writer *W = csr_file_writer_open(path, A->rows, A->cols, A->nnz);
+    if (!W) return -1;
+    
+    // The whole matrix as one panel
+    csr_file_writer_append(W, A);
+    if (csr_file_writer_close(W) != 0) {
+        printf("Error: Could not write %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+CSR_File* csr_file_open(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: Could not open %s\n", path);
+        return NULL;
+    }
+    
+    char magic[8];
+    int64_t header[3];
+    if (pread(fd, magic, 8, 0) != 8 ||
+        memcmp(magic, CSR_FILE_MAGIC, 8) != 0 ||
+        pread(fd, header, sizeof(header), 8) != (ssize_t)sizeof(header)) {
+        printf("Error: %s is not a binary CSR file\n", path);
+        close(fd);
+        return NULL;
+    }
+    
+    CSR_File *F = (CSR_File*)malloc(sizeof(CSR_File));
+    F->fd = fd;
+    F->rows = (int)header[0];
+    F->cols = (int)header[1];
+    F->nnz = header[2];
+    
+    size_t ptr_bytes = ((size_t)F->rows + 1) * sizeof(int64_t);
+    int64_t ptr_offset = 8 + sizeof(header);
+    F->col_offset = ptr_offset + (int64_t)ptr_bytes;
+    F->val_offset = F->col_offset + F->nnz * (int64_t)sizeof(int);
+    
+    F->row_ptr = (int64_t*)malloc(ptr_bytes);
+    if (pread(fd, F->row_ptr, ptr_bytes, ptr_offset) != (ssize_t)ptr_bytes) {
+        printf("Error: Truncated binary CSR file %s\n", path);
+        csr_file_close(F);
+        return NULL;
+    }
+    
+    return F;
+}
+
+CSR64_Matrix* csr64_read_binary(const char *path) {
+    CSR_File *F = csr_file_open(path);
+    if (!F) return NULL;
+    
+    CSR64_Matrix *A = csr64_alloc(F->rows, F->cols, F->nnz);
+    if (!A) {
+        printf("Error: Not enough memory for %lld nonzeros of %s\n", (long long)F->nnz, path);
+        csr_file_close(F);
+        return NULL;
+    }
+    
+    // row_ptr is already resident in F: take it over
+    free(A->row_ptr);
+    A->row_ptr = F->row_ptr;
+    F->row_ptr = NULL;
+    
+    if (read_full(F->fd, A->col_idx, (size_t)F->nnz * sizeof(int), F->col_offset) != 0 ||
+        read_full(F->fd, A->values, (size_t)F->nnz * sizeof(double), F->val_offset) != 0) {
+        printf("Error: Truncated binary CSR file %s\n", path);
+        csr64_free(A);
+        csr_file_close(F);
+        return NULL;
+    }
+    
+    csr_file_close(F);
+    return A;
+}
+
+void csr_file_close(CSR_File *F) {
+    if (F) {
+        close(F->fd);
+        free(F->row_ptr);
+        free(F);
+    }
+}
+
+// ============================================
+// Mixed-Precision Conversion
+// ============================================
+
+// float -> bfloat16, round to nearest even
+static uint16_t float_to_bf16(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+        return (uint16_t)((bits >> 16) | 0x40);   // keep NaN quiet
+    }
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return (uint16_t)(bits >> 16);
+}
+
+// float -> IEEE half, round to nearest even
+static uint16_t float_to_half(float f) {
+#ifdef __F16C__
+    return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t fexp = (bits >> 23) & 0xFF;
+    uint32_t mant = bits & 0x7FFFFF;
+    int exp = (int)fexp - 127 + 15;
+    
+    if (fexp == 0xFF) return (uint16_t)(sign | 0x7C00 | (mant ? 0x200 : 0));
+    if (exp >= 31) return (uint16_t)(sign | 0x7C00);
+    
+    if (exp <= 0) {
+        // Subnormal half (or underflow to zero)
+        if (exp < -10) return (uint16_t)sign;
+        mant |= 0x800000;
+        int shift = 14 - exp;
+        uint32_t h = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1);
+        uint32_t mid = 1u << (shift - 1);
+        if (rem > mid || (rem == mid && (h & 1))) h++;
+        return (uint16_t)(sign | h);
+    }
+    
+    uint32_t h = sign | ((uint32_t)exp << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++;
+    return (uint16_t)h;
+#endif
+}
+
+// Convert n doubles into a freshly allocated reduced-precision array
+static void* convert_values(const double *src, size_t n, int value_type) {
+    if (value_type == VALUE_F32) {
+        float *dst = (float*)malloc(n * sizeof(float));
+        for (size_t k = 0; k < n; k++) dst[k] = (float)src[k];
+        return dst;
+    }
+    
+    uint16_t *dst = (uint16_t*)malloc(n * sizeof(uint16_t));
+    for (size_t k = 0; k < n; k++) {
+        dst[k] = (value_type == VALUE_BF16) ? float_to_bf16((float)src[k])
+                                            : float_to_half((float)src[k]);
+    }
+    return dst;
+}
+
+CSR_MP_Matrix* csr_to_csr_mp(const CSR_Matrix *A, int value_type) {
+    CSR_MP_Matrix *B = (CSR_MP_Matrix*)malloc(sizeof(CSR_MP_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    B->value_type = value_type;
+    B->row_ptr = (int*)malloc((A->rows + 1) * sizeof(int));
+    B->col_idx = (int*)malloc((size_t)A->nnz * sizeof(int));
+    
+    memcpy(B->row_ptr, A->row_ptr, (A->rows + 1) * sizeof(int));
+    memcpy(B->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    B->values = convert_values(A->values, A->nnz, value_type);
+    
+    return B;
+}
+
+void csr_mp_free(CSR_MP_Matrix *A) {
+    if (A) {
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A->values);
+        free(A);
+    }
+}
+
+BCSR_MP_Matrix* bcsr_to_bcsr_mp(const BCSR_Matrix *A, int value_type) {
+    BCSR_MP_Matrix *B = (BCSR_MP_Matrix*)malloc(sizeof(BCSR_MP_Matrix));
+    
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->block_rows = A->block_rows;
+    B->block_cols = A->block_cols;
+    B->num_blocks = A->num_blocks;
+    B->value_type = value_type;
+    B->block_row_ptr = (int*)malloc((A->block_rows + 1) * sizeof(int));
+    B->block_col_idx = (int*)malloc((size_t)A->num_blocks * sizeof(int));
+    
+    memcpy(B->block_row_ptr, A->block_row_ptr, (A->block_rows + 1) * sizeof(int));
+    memcpy(B->block_col_idx, A->block_col_idx, (size_t)A->num_blocks * sizeof(int));
+    B->block_val = convert_values(A->block_val, (size_t)A->num_blocks * 16, value_type);
+    
+    return B;
+}
+
+void bcsr_mp_free(BCSR_MP_Matrix *A) {
+    if (A) {
+        free(A->block_row_ptr);
+        free(A->block_col_idx);
+        free(A->block_val);
+        free(A);
+    }
+}
+
+// ============================================
+// Dictionary-Compressed Values
+// ============================================
+
+// Hash of the value's bit pattern (so 0.0 and -0.0 stay distinct)
+static inline uint32_t dict_hash(uint64_t bits) {
+    return (uint32_t)((bits * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+CSR_Dict_Matrix* csr_to_csr_dict(const CSR_Matrix *A) {
+    // Open-addressing table at ≤50% load; bail out as soon as the
+    // number of distinct values exceeds what a 2-byte code can hold
+    const uint32_t slots = 2 * DICT_MAX_U16;
+    uint64_t *keys = (uint64_t*)malloc(slots * sizeof(uint64_t));
+    int *slot_code = (int*)malloc(slots * sizeof(int));
+    int *codes = (int*)malloc((size_t)A->nnz * sizeof(int));
+    double *table = (double*)malloc(DICT_MAX_U16 * sizeof(double));
+    for (uint32_t s = 0; s < slots; s++) slot_code[s] = -1;
+    
+    int distinct = 0;
+    for (int k = 0; k < A->nnz; k++) {
+        uint64_t bits;
+        memcpy(&bits, &A->values[k], sizeof(bits));
+        
+        uint32_t s = dict_hash(bits) & (slots - 1);
+        while (slot_code[s] >= 0 && keys[s] != bits) {
+            s = (s + 1) & (slots - 1);
+        }
+        if (slot_code[s] < 0) {
+            if (distinct == DICT_MAX_U16) {
+                distinct = -1;
+                break;
+            }
+            keys[s] = bits;
+            slot_code[s] = distinct;
+            table[distinct++] = A->values[k];
+        }
+        codes[k] = slot_code[s];
+    }
+    free(keys);
+    free(slot_code);
+    
+    if (distinct < 0) {
+        free(codes);
+        free(table);
+        return NULL;
+    }
+    
+    CSR_Dict_Matrix *B = (CSR_Dict_Matrix*)malloc(sizeof(CSR_Dict_Matrix));
+    B->rows = A->rows;
+    B->cols = A->cols;
+    B->nnz = A->nnz;
+    B->code_bytes = (distinct <= DICT_MAX_U8) ? 1 : 2;
+    B->table_size = distinct;
+    B->table = (double*)realloc(table, (distinct > 0 ? distinct : 1) * sizeof(double));
+    B->row_ptr = (int*)malloc((A->rows + 1) * sizeof(int));
+    B->col_idx = (int*)malloc((size_t)A->nnz * sizeof(int));
+    B->codes = malloc((size_t)A->nnz * B->code_bytes);
+    
+    memcpy(B->row_ptr, A->row_ptr, (A->rows + 1) * sizeof(int));
+    memcpy(B->col_idx, A->col_idx, (size_t)A->nnz * sizeof(int));
+    
+    if (B->code_bytes == 1) {
+        uint8_t *c = (uint8_t*)B->codes;
+        for (int k = 0; k < A->nnz; k++) c[k] = (uint8_t)codes[k];
+    } else {
+        uint16_t *c = (uint16_t*)B->codes;
+        for (int k = 0; k < A->nnz; k++) c[k] = (uint16_t)codes[k];
+    }
+    free(codes);
+    
+    return B;
+}
+
+void csr_dict_free(CSR_Dict_Matrix *A) {
+    if (A) {
+        free(A->table);
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A->codes);
+        free(A);
+    }
+}
@@ -9,6 +9,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
 
 // ============================================
 // CSR Matrix Format
@@ -22,6 +27,94 @@ typedef struct {
     double *values;    // Size: nnz
 } CSR_Matrix;
 
+// ============================================
+// CSC Matrix Format (column-major CSR)
+// ============================================
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int *col_ptr;      // Size: cols+1
+    int *row_idx;      // Size: nnz (ascending within a column)
+    double *values;    // Size: nnz
+} CSC_Matrix;
+
+// ============================================
+// Compressed Sparse Blocks (CSB)
+// ============================================
+// β×β blocks in row-major block order; entries inside a block carry
+// 16-bit local (row, col) and are stored in Z-Morton order. Neither
+// rows nor columns are favoured, so A·x and Aᵀ·x run on the same
+// storage.
+#define CSB_MAX_BETA   65536   // Local indices must fit in 16 bits
+#define CSB_BLOCK_NNZ  256     // Target mean nnz per block when sizing β
+
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int beta;          // Block side (power of two, ≥ √n)
+    int lg_beta;       // log2(beta)
+    int block_rows;
+    int block_cols;
+    int *blk_ptr;      // Size: block_rows·block_cols + 1
+    uint32_t *idx;     // Size: nnz, (local row << 16) | local col
+    double *values;    // Size: nnz
+} CSB_Matrix;
+
+// ============================================
+// CSR Matrix Format (64-bit row_ptr)
+// ============================================
+// Same layout as CSR_Matrix, but nnz and row offsets are 64-bit so
+// matrices with more than 2^31 nonzeros can be represented.
+// Column indices stay 32-bit to keep the per-nonzero stream at 12 bytes.
+typedef struct {
+    int rows;
+    int cols;
+    int64_t nnz;
+    int64_t *row_ptr;  // Size: rows+1
+    int *col_idx;      // Size: nnz
+    double *values;    // Size: nnz
+} CSR64_Matrix;
+
+// ============================================
+// CSR-DU Matrix Format (delta-encoded columns)
+// ============================================
+// Column indices are stored as one byte stream of "units". Each unit
+// is a 1-byte header followed by `count` column deltas of one width
+// (8, 16 or 32 bit); 32-bit units are the escape for large jumps and
+// for negative deltas (unsigned wrap-around). A unit flagged NEW_ROW
+// starts the next row, and its first delta is relative to the first
+// column of the previous row (0 at the start of a group), so banded
+// and stencil rows start with a 1-byte delta. An EMPTY unit stands
+// for `count` empty rows and carries no deltas.
+//
+// Rows come in groups of CSRDU_GROUP; only groups have pointers into
+// ctl and values, so there is no per-row index array.
+//
+// Header byte: bits 0-1 = width (CSRDU_U8/U16/U32, or CSRDU_EMPTY)
+//              bits 2-6 = count - 1 (1..CSRDU_MAX_UNIT)
+//              bit  7   = CSRDU_NEW_ROW
+#define CSRDU_U8        0
+#define CSRDU_U16       1
+#define CSRDU_U32       2
+#define CSRDU_EMPTY     3
+#define CSRDU_NEW_ROW   0x80
+#define CSRDU_MAX_UNIT  32
+#define CSRDU_GROUP     64     // Rows per group (one scheduling chunk)
+#define CSRDU_PAD       32     // ctl slack for 8-delta SIMD over-reads
+
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int num_groups;
+    int *grp_val;      // Size: num_groups+1 (index into values)
+    int *grp_ctl;      // Size: num_groups+1 (byte offset into ctl)
+    uint8_t *ctl;      // Size: grp_ctl[num_groups] + CSRDU_PAD bytes
+    double *values;    // Size: nnz
+} CSRDU_Matrix;
+
 // ============================================
 // BCSR Matrix Format (4×4 blocks)
 // ============================================
@@ -36,6 +129,237 @@ typedef struct {
     double *block_val;    // Size: num_blocks × 16
 } BCSR_Matrix;
 
+// ============================================
+// Pattern-Only Formats (uniform values)
+// ============================================
+// For matrices whose stored entries all have the same value (e.g.
+// adjacency matrices, value = 1.0), only the structure is kept and
+// kernels compute y = value · (pattern · x) without streaming values.
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    double value;      // Common value of every stored entry
+    int *row_ptr;      // Size: rows+1
+    int *col_idx;      // Size: nnz
+} CSR_Pattern_Matrix;
+
+// 4×4 blocks stored as a 16-bit mask: bit (i*4 + j) = entry (i, j)
+typedef struct {
+    int rows;
+    int cols;
+    int block_rows;
+    int block_cols;
+    int num_blocks;
+    double value;         // Common value of every stored entry
+    int *block_row_ptr;   // Size: block_rows+1
+    int *block_col_idx;   // Size: num_blocks
+    uint16_t *block_mask; // Size: num_blocks
+} BCSR_Pattern_Matrix;
+
+// ============================================
+// CSR5-Style Tiles
+// ============================================
+// nnz is cut into tiles of CSR5_OMEGA lanes × CSR5_SIGMA entries.
+// Lane l of a tile owns the CSR5_SIGMA consecutive entries starting at
+// tile_base + l·CSR5_SIGMA. Full tiles store col_idx/values transposed
+// (entry p of lane l at tile_base + p·CSR5_OMEGA + l), so one step of
+// all lanes is a contiguous load; the last, partial tile keeps CSR
+// order. Each tile adds a row ordinal and a 64-bit row-start mask.
+#define CSR5_OMEGA  4      // Lanes per tile (AVX2: 4 doubles)
+#define CSR5_SIGMA  16     // Entries per lane
+#define CSR5_TILE   (CSR5_OMEGA * CSR5_SIGMA)   // 64 = bits in tile_mask
+
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int *col_idx;          // Size: nnz, tile-transposed copy
+    double *values;        // Size: nnz, tile-transposed copy
+    int num_tiles;
+    int *tile_row;         // Size: num_tiles, ordinal of the first entry's row
+    uint64_t *tile_mask;   // Size: num_tiles, bit e = entry e (CSR order) starts a row
+    int *nz_rows;          // Ordinal → row id (NULL if no empty rows)
+} CSR5_Matrix;
+
+// ============================================
+// On-Disk CSR (binary, for out-of-core SpMV)
+// ============================================
+// File layout (native byte order):
+//   char    magic[8]          "SPMVCSR1"
+//   int64_t rows, cols, nnz
+//   int64_t row_ptr[rows+1]
+//   int32_t col_idx[nnz]
+//   double  values[nnz]
+// Only row_ptr is kept in memory; col_idx/values are read in panels.
+#define CSR_FILE_MAGIC "SPMVCSR1"
+
+typedef struct {
+    int fd;
+    int rows;
+    int cols;
+    int64_t nnz;
+    int64_t *row_ptr;     // Size: rows+1 (resident)
+    int64_t col_offset;   // File offset of col_idx
+    int64_t val_offset;   // File offset of values
+} CSR_File;
+
+// Row-panel writer: the file is produced a block of rows at a time, so a
+// matrix larger than RAM never has to be resident. nnz is fixed up front
+// (it determines where col_idx and values start).
+typedef struct {
+    int fd;
+    int rows;
+    int cols;
+    int64_t nnz;
+    int rows_written;
+    int64_t nnz_written;
+    int64_t col_offset;   // File offset of col_idx
+    int64_t val_offset;   // File offset of values
+    int error;            // Set by a failed append; close then fails
+} CSR_File_Writer;
+
+// ============================================
+// Mixed-Precision Formats (reduced-precision values)
+// ============================================
+// Same index structure as CSR_Matrix / BCSR_Matrix, but values are
+// stored as float, bfloat16 or IEEE half. Kernels convert on load
+// and accumulate in double.
+#define VALUE_F32   0      // float    (4 bytes)
+#define VALUE_BF16  1      // bfloat16 (2 bytes, 8-bit mantissa)
+#define VALUE_F16   2      // IEEE half (2 bytes, F16C when available)
+
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int value_type;    // VALUE_F32 / VALUE_BF16 / VALUE_F16
+    int *row_ptr;      // Size: rows+1
+    int *col_idx;      // Size: nnz
+    void *values;      // Size: nnz (float or uint16_t)
+} CSR_MP_Matrix;
+
+typedef struct {
+    int rows;
+    int cols;
+    int block_rows;
+    int block_cols;
+    int num_blocks;
+    int value_type;       // VALUE_F32 / VALUE_BF16 / VALUE_F16
+    int *block_row_ptr;   // Size: block_rows+1
+    int *block_col_idx;   // Size: num_blocks
+    void *block_val;      // Size: num_blocks × 16 (float or uint16_t)
+} BCSR_MP_Matrix;
+
+// Bytes per stored value
+static inline int value_type_size(int value_type) {
+    return (value_type == VALUE_F32) ? 4 : 2;
+}
+
+// bfloat16 -> float (upper 16 bits of a float)
+static inline float bf16_to_float(uint16_t h) {
+    uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// IEEE half -> float
+static inline float half_to_float(uint16_t h) {
+#ifdef __F16C__
+    return _cvtsh_ss(h);
+#else
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+    uint32_t bits;
+    
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {
+            // Subnormal: renormalize
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400)) {
+                mant <<= 1;
+                exp--;
+            }
+            bits = sign | (exp << 23) | ((mant & 0x3FF) << 13);
+        }
+    } else if (exp == 31) {
+        bits = sign | 0x7F800000 | (mant << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+    
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+#endif
+}
+
+// ============================================
+// Dictionary-Compressed Values
+// ============================================
+// Stencil / FEM matrices hold few distinct coefficients. Values are
+// replaced by 1- or 2-byte codes into a table of doubles; decoding is
+// exact (the table holds the original bits). A 1-byte table (≤256
+// values, ≤2 KB) stays in L1; a full 2-byte table is 512 KB (L2 or L3).
+#define DICT_MAX_U8   256
+#define DICT_MAX_U16  65536
+
+typedef struct {
+    int rows;
+    int cols;
+    int nnz;
+    int code_bytes;    // 1 (≤256 distinct) or 2 (≤65536 distinct)
+    int table_size;    // Number of distinct values
+    double *table;     // Size: table_size
+    int *row_ptr;      // Size: rows+1
+    int *col_idx;      // Size: nnz
+    void *codes;       // Size: nnz (uint8_t or uint16_t)
+} CSR_Dict_Matrix;
+
+// ============================================
+// α/β Update (y = α·A·x + β·y, Sparse BLAS mv)
+// ============================================
+// Each *_mv kernel is instantiated once per mode, so the common cases
+// never multiply by 1 and never read y when β = 0 (y may hold garbage).
+#define MV_STORE_A1_B0(y, s, alpha, beta)  ((y) = (s))
+#define MV_STORE_B0(y, s, alpha, beta)     ((y) = (alpha) * (s))
+#define MV_STORE_A1_B1(y, s, alpha, beta)  ((y) += (s))
+#define MV_STORE_B1(y, s, alpha, beta)     ((y) += (alpha) * (s))
+#define MV_STORE_AB(y, s, alpha, beta)     ((y) = (alpha) * (s) + (beta) * (y))
+
+#define MV_MODE_LIST(X)            \
+    X(a1_b0, MV_STORE_A1_B0)       \
+    X(b0,    MV_STORE_B0)          \
+    X(a1_b1, MV_STORE_A1_B1)       \
+    X(b1,    MV_STORE_B1)          \
+    X(ab,    MV_STORE_AB)
+
+// y = β·y (α = 0: A is not read)
+static inline void mv_scale(double *y, int n, double beta) {
+    if (beta == 0.0) {
+        memset(y, 0, n * sizeof(double));
+    } else if (beta != 1.0) {
+        for (int i = 0; i < n; i++) y[i] *= beta;
+    }
+}
+
+// Call PREFIX##_<mode>(alpha, A, x, beta, y) for the matching mode
+#define MV_DISPATCH(PREFIX, alpha, A, x, beta, y)                  \
+    do {                                                            \
+        if ((alpha) == 0.0) mv_scale((y), (A)->rows, (beta));       \
+        else if ((beta) == 0.0) {                                   \
+            if ((alpha) == 1.0) PREFIX##_a1_b0(alpha, A, x, beta, y); \
+            else PREFIX##_b0(alpha, A, x, beta, y);                 \
+        } else if ((beta) == 1.0) {                                 \
+            if ((alpha) == 1.0) PREFIX##_a1_b1(alpha, A, x, beta, y); \
+            else PREFIX##_b1(alpha, A, x, beta, y);                 \
+        } else PREFIX##_ab(alpha, A, x, beta, y);                   \
+    } while (0)
+
 // ============================================
 // Matrix Memory Management
 // ============================================
@@ -49,10 +373,106 @@ void csr_free(CSR_Matrix *A);
 // Generate random CSR matrix
 CSR_Matrix* csr_random(int n, double density);
 
+// Allocate CSR matrix with 64-bit row_ptr (NULL if out of memory)
+CSR64_Matrix* csr64_alloc(int rows, int cols, int64_t nnz);
+
+// Free CSR matrix with 64-bit row_ptr
+void csr64_free(CSR64_Matrix *A);
+
+// Generate 2D 5-point Laplacian (nx·ny rows, values 4 and -1)
+CSR_Matrix* csr_laplacian_2d(int nx, int ny);
+
+// Generate n×n matrix with Pareto (heavy-tailed) row lengths, mean ≈ avg_nnz
+CSR_Matrix* csr_power_law(int n, int avg_nnz);
+
+// Symmetric permutation B = P A Pᵀ (perm[new] = old, A square)
+CSR_Matrix* csr_permute(const CSR_Matrix *A, const int *perm);
+
+// 1 if every stored value of A is identical (*value receives it)
+int csr_is_uniform(const CSR_Matrix *A, double *value);
+
+// Convert CSR to pattern-only CSR (NULL if values are not uniform)
+CSR_Pattern_Matrix* csr_to_pattern(const CSR_Matrix *A);
+
+// Free pattern-only CSR matrix
+void csr_pattern_free(CSR_Pattern_Matrix *A);
+
+// Convert CSR to pattern-only BCSR (NULL if values are not uniform)
+BCSR_Pattern_Matrix* csr_to_bcsr_pattern(const CSR_Matrix *A);
+
+// Free pattern-only BCSR matrix
+void bcsr_pattern_free(BCSR_Pattern_Matrix *A);
+
+// Convert CSR to CSR5 tiles (O(nnz) copy, transposed per tile)
+CSR5_Matrix* csr_to_csr5(const CSR_Matrix *A);
+
+// Free CSR5 matrix
+void csr5_free(CSR5_Matrix *A);
+
+// Convert CSR to CSC
+CSC_Matrix* csr_to_csc(const CSR_Matrix *A);
+
+// Free CSC matrix
+void csc_free(CSC_Matrix *A);
+
+// Convert CSR to CSB (β chosen from the dimensions and nnz)
+CSB_Matrix* csr_to_csb(const CSR_Matrix *A);
+
+// Free CSB matrix
+void csb_free(CSB_Matrix *A);
+
+// Convert CSR to CSR with 64-bit row_ptr (NULL if out of memory)
+CSR64_Matrix* csr_to_csr64(const CSR_Matrix *A);
+
+// Convert CSR to CSR-DU (delta-encoded columns)
+CSRDU_Matrix* csr_to_csrdu(const CSR_Matrix *A);
+
+// Free CSR-DU matrix
+void csrdu_free(CSRDU_Matrix *A);
+
 // Convert CSR to BCSR (4×4)
 BCSR_Matrix* csr_to_bcsr(const CSR_Matrix *A);
 
 // Free BCSR matrix
 void bcsr_free(BCSR_Matrix *A);
 
+// Write CSR matrix to a binary file (returns 0 on success)
+int csr_write_binary(const CSR_Matrix *A, const char *path);
+
+// Start a binary CSR file of the given shape, NULL on failure
+CSR_File_Writer* csr_file_writer_open(const char *path, int rows, int cols, int64_t nnz);
+
+// Append the next panel->rows rows (panel->row_ptr starts at 0); 0 on success
+int csr_file_writer_append(CSR_File_Writer *W, const CSR_Matrix *panel);
+
+// Check every row and nonzero was written, fsync and close (0 on success)
+int csr_file_writer_close(CSR_File_Writer *W);
+
+// Open binary CSR file (loads row_ptr only), NULL on failure
+CSR_File* csr_file_open(const char *path);
+
+// Close binary CSR file
+void csr_file_close(CSR_File *F);
+
+// Load a whole binary CSR file as CSR64 (nnz may exceed 2³¹), NULL on failure
+CSR64_Matrix* csr64_read_binary(const char *path);
+
+// Convert CSR to reduced-precision CSR (value_type: VALUE_*)
+CSR_MP_Matrix* csr_to_csr_mp(const CSR_Matrix *A, int value_type);
+
+// Free reduced-precision CSR matrix
+void csr_mp_free(CSR_MP_Matrix *A);
+
+// Convert BCSR to reduced-precision BCSR (value_type: VALUE_*)
+BCSR_MP_Matrix* bcsr_to_bcsr_mp(const BCSR_Matrix *A, int value_type);
+
+// Free reduced-precision BCSR matrix
+void bcsr_mp_free(BCSR_MP_Matrix *A);
+
+// Convert CSR to dictionary-coded CSR (NULL if >65536 distinct values)
+CSR_Dict_Matrix* csr_to_csr_dict(const CSR_Matrix *A);
+
+// Free dictionary-coded CSR matrix
+void csr_dict_free(CSR_Dict_Matrix *A);
+
 #endif // COMMON_H
@@ -0,0 +1,33 @@
+/**
+ * Compressed Sparse Blocks (CSB) SpMV
+ * A·x and Aᵀ·x from one copy of the matrix
+ */
+
+#ifndef CSB_PARALLEL_H
+#define CSB_PARALLEL_H
+
+#include "common.h"
+
+// Block ranges holding more entries than this are split into tasks
+#define CSB_SPLIT_NNZ 8192
+
+/**
+ * CSB SpMV: y = A·x (y has A->rows entries)
+ * 
+ * One task per block row (dynamic, 1). A heavy block row is split
+ * recursively by nnz: one half runs as an OpenMP task into a private
+ * β-sized buffer that is added back after taskwait, so dense rows
+ * get several threads without atomics.
+ */
+void spmv_csb_parallel(const CSB_Matrix *A, const double *x, double *y);
+
+/**
+ * CSB transpose SpMV: y = Aᵀ·x (y has A->cols entries)
+ * 
+ * Same recursion over block columns: each block column owns a β
+ * slice of y, reading the blocks (0..block_rows-1, bc) in place.
+ * CSR can only do this with atomics or a second (CSC) copy.
+ */
+void spmv_csb_transpose_parallel(const CSB_Matrix *A, const double *x, double *y);
+
+#endif // CSB_PARALLEL_H
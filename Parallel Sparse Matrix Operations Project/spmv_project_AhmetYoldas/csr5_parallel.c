@@ -0,0 +1,125 @@
+/**
+ * CSR5-Style SpMV Implementation
+ */
+
+#include "csr5_parallel.h"
+#include <omp.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// Last entry of every lane (bits σ-1, 2σ-1, ...)
+static uint64_t csr5_lane_end_mask(void) {
+    uint64_t m = 0;
+    for (int l = 0; l < CSR5_OMEGA; l++) {
+        m |= 1ULL << (l * CSR5_SIGMA + CSR5_SIGMA - 1);
+    }
+    return m;
+}
+
+static inline void csr5_tile(const CSR5_Matrix *A, int t, uint64_t lane_end,
+                             const double *x, double *y, double *tile_carry) {
+    const int base = t * CSR5_TILE;
+    const int count = (A->nnz - base < CSR5_TILE) ? A->nnz - base : CSR5_TILE;
+    const uint64_t mask = A->tile_mask[t];
+    const uint64_t valid = (count == CSR5_TILE) ? ~0ULL : (1ULL << count) - 1;
+    const uint64_t end = (lane_end | (mask >> 1) | (1ULL << (count - 1))) & valid;
+    
+    // Segmented sum: run[p·ω + l] = running sum of lane l after step p.
+    // The last tile (CSR order) is padded by clamping to its final entry; padded
+    // positions are never read back (end is masked to valid entries).
+    double run[CSR5_TILE];
+    double sum[CSR5_OMEGA] = {0.0};
+    const double *val = A->values + base;
+    const int *col = A->col_idx + base;
+    if (count == CSR5_TILE) {
+#if defined(__AVX2__) && defined(__FMA__) && CSR5_OMEGA == 4
+        // One __m256d = the 4 lanes; step p is entries [4p, 4p+4)
+        const __m256i lane_e64 = _mm256_setr_epi64x(0, CSR5_SIGMA, 2 * CSR5_SIGMA, 3 * CSR5_SIGMA);
+        const __m256i end_v = _mm256_set1_epi64x((long long)end);
+        const __m256i one = _mm256_set1_epi64x(1);
+        __m256d acc = _mm256_setzero_pd();
+        for (int p = 0; p < CSR5_SIGMA; p++) {
+            __m128i c = _mm_loadu_si128((const __m128i*)&col[p * CSR5_OMEGA]);
+            __m256d v = _mm256_loadu_pd(&val[p * CSR5_OMEGA]);
+            __m256d xv = _mm256_i32gather_pd(x, c, 8);
+            acc = _mm256_fmadd_pd(v, xv, acc);
+            _mm256_storeu_pd(&run[p * CSR5_OMEGA], acc);
+            
+            // Reset lanes whose row piece ends at this step
+            __m256i bit = _mm256_srlv_epi64(end_v, _mm256_add_epi64(lane_e64, _mm256_set1_epi64x(p)));
+            __m256i ends = _mm256_cmpeq_epi64(_mm256_and_si256(bit, one), one);
+            acc = _mm256_andnot_pd(_mm256_castsi256_pd(ends), acc);
+        }
+#else
+        for (int p = 0; p < CSR5_SIGMA; p++) {
+            #pragma omp simd
+            for (int l = 0; l < CSR5_OMEGA; l++) {
+                int e = l * CSR5_SIGMA + p;
+                double s = sum[l] + val[p * CSR5_OMEGA + l] * x[col[p * CSR5_OMEGA + l]];
+                run[p * CSR5_OMEGA + l] = s;
+                sum[l] = ((end >> e) & 1) ? 0.0 : s;
+            }
+        }
+#endif
+    } else {
+        for (int p = 0; p < CSR5_SIGMA; p++) {
+            for (int l = 0; l < CSR5_OMEGA; l++) {
+                int e = l * CSR5_SIGMA + p;
+                int ec = (e < count) ? e : count - 1;
+                double s = sum[l] + val[ec] * x[col[ec]];
+                run[p * CSR5_OMEGA + l] = s;
+                sum[l] = ((end >> e) & 1) ? 0.0 : s;
+            }
+        }
+    }
+    
+    // Scatter row pieces in entry order
+    const int first = A->tile_row[t];
+    int ord = first;
+    int s = 0;
+    double carry = 0.0;
+    uint64_t pending = end;
+    while (pending) {
+        int e = __builtin_ctzll(pending);
+        pending &= pending - 1;
+        
+        int starts_row = (int)((mask >> s) & 1);
+        if (starts_row && s > 0) ord++;
+        
+        double v = run[(e % CSR5_SIGMA) * CSR5_OMEGA + e / CSR5_SIGMA];
+        int row = A->nz_rows ? A->nz_rows[ord] : ord;
+        if (starts_row) {
+            y[row] = v;
+        } else if (ord == first && !(mask & 1)) {
+            carry += v;
+        } else {
+            y[row] += v;
+        }
+        s = e + 1;
+    }
+    tile_carry[t] = carry;
+}
+
+void spmv_csr5_parallel(const CSR5_Matrix *A, const double *x, double *y,
+                        double *tile_carry) {
+    const uint64_t lane_end = csr5_lane_end_mask();
+    
+    // Empty rows are never visited by a tile
+    if (A->nz_rows) {
+        memset(y, 0, A->rows * sizeof(double));
+    }
+    
+    #pragma omp parallel for schedule(static)
+    for (int t = 0; t < A->num_tiles; t++) {
+        csr5_tile(A, t, lane_end, x, y, tile_carry);
+    }
+    
+    // Calibrate rows that cross tile boundaries
+    for (int t = 0; t < A->num_tiles; t++) {
+        if (!(A->tile_mask[t] & 1)) {
+            int ord = A->tile_row[t];
+            y[A->nz_rows ? A->nz_rows[ord] : ord] += tile_carry[t];
+        }
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * CSR5-Style SpMV
+ * Equal-nnz tiles with a vectorized segmented sum
+ */
+
+#ifndef CSR5_PARALLEL_H
+#define CSR5_PARALLEL_H
+
+#include "common.h"
+
+/**
+ * CSR5 SpMV: y = A·x using tiles from csr_to_csr5
+ * 
+ * Every tile holds exactly CSR5_TILE nonzeros, so the static schedule
+ * over tiles is balanced whatever the row lengths are. Within a tile:
+ * 
+ * 1. Segmented sum: the CSR5_OMEGA lanes advance in lockstep (one
+ *    entry per lane per step, omp simd); a lane's running sum is
+ *    saved every step and reset where the row-start mask says a row
+ *    ends, so the inner loop has no branches
+ * 2. Row pieces are read back at the set bits of the end mask (ctz
+ *    walk, one step per row): pieces that start a row assign y, later
+ *    pieces of the same row add to it
+ * 3. The piece of a row begun in an earlier tile goes to tile_carry
+ *    and is added once all tiles are done
+ * 
+ * Full tiles are stored step-major (see CSR5_Matrix), so each step
+ * loads the ω lanes' col/val contiguously and only x is gathered.
+ * tile_carry is caller-owned scratch of A->num_tiles doubles; A itself
+ * is read-only, so concurrent SpMVs may share it with their own
+ * workspaces.
+ */
+void spmv_csr5_parallel(const CSR5_Matrix *A, const double *x, double *y,
+                        double *tile_carry);
+
+#endif // CSR5_PARALLEL_H
@@ -0,0 +1,34 @@
+/**
+ * CSR with 64-bit row_ptr Implementation
+ * Kernels generated for both index widths
+ */
+
+#include "csr64_parallel.h"
+#include <omp.h>
+
+// Generates serial + parallel kernels for one row_ptr type.
+// PTR_T is the type of row_ptr entries (and of the nonzero cursor k).
+#define DEFINE_CSR_INDEX_KERNELS(TAG, MATRIX_T, PTR_T)                      \
+void spmv_csr_##TAG##_serial(const MATRIX_T *A, const double *x, double *y) { \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (PTR_T k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {           \
+            sum += A->values[k] * x[A->col_idx[k]];                         \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+void spmv_csr_##TAG##_parallel(const MATRIX_T *A, const double *x, double *y) { \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (PTR_T k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {           \
+            sum += A->values[k] * x[A->col_idx[k]];                         \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}
+
+DEFINE_CSR_INDEX_KERNELS(idx32, CSR_Matrix, int)
+DEFINE_CSR_INDEX_KERNELS(idx64, CSR64_Matrix, int64_t)
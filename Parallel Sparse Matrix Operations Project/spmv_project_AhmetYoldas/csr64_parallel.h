@@ -0,0 +1,31 @@
+/**
+ * CSR with 64-bit row_ptr
+ * Index-width variants of the CSR serial/parallel kernels
+ */
+
+#ifndef CSR64_PARALLEL_H
+#define CSR64_PARALLEL_H
+
+#include "common.h"
+
+/**
+ * CSR SpMV, generated for both row_ptr widths
+ * 
+ * The same kernel body is instantiated twice:
+ * - idx32: CSR_Matrix   (int row_ptr,     int col_idx)
+ * - idx64: CSR64_Matrix (int64_t row_ptr, int col_idx)
+ * 
+ * Only the row_ptr stream changes width, so timing the two
+ * instantiations against each other isolates the bandwidth cost
+ * of 64-bit row offsets (4 extra bytes per row).
+ * 
+ * The parallel kernels use the same schedule as Method 2
+ * (dynamic, chunk size 64).
+ */
+void spmv_csr_idx32_serial(const CSR_Matrix *A, const double *x, double *y);
+void spmv_csr_idx32_parallel(const CSR_Matrix *A, const double *x, double *y);
+
+void spmv_csr_idx64_serial(const CSR64_Matrix *A, const double *x, double *y);
+void spmv_csr_idx64_parallel(const CSR64_Matrix *A, const double *x, double *y);
+
+#endif // CSR64_PARALLEL_H
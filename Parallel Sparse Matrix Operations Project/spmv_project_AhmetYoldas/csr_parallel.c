@@ -5,13 +5,28 @@
 #include "csr_parallel.h"
 #include <omp.h>
 
+// One instantiation per α/β mode (see MV_MODE_LIST)
+#define DEFINE_CSR_PARALLEL_MV(MODE, STORE)                                 \
+static void csr_parallel_mv_##MODE(double alpha, const CSR_Matrix *A,       \
+                                   const double *x, double beta, double *y) { \
+    (void)alpha; (void)beta;                                                \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum += A->values[k] * x[A->col_idx[k]];                         \
+        }                                                                   \
+        STORE(y[i], sum, alpha, beta);                                      \
+    }                                                                       \
+}
+
+MV_MODE_LIST(DEFINE_CSR_PARALLEL_MV)
+
 void spmv_csr_parallel(const CSR_Matrix *A, const double *x, double *y) {
-    #pragma omp parallel for schedule(dynamic, 64)
-    for (int i = 0; i < A->rows; i++) {
-        double sum = 0.0;
-        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {
-            sum += A->values[k] * x[A->col_idx[k]];
-        }
-        y[i] = sum;
-    }
+    csr_parallel_mv_a1_b0(1.0, A, x, 0.0, y);
+}
+
+void spmv_csr_parallel_mv(double alpha, const CSR_Matrix *A, const double *x,
+                          double beta, double *y) {
+    MV_DISPATCH(csr_parallel_mv, alpha, A, x, beta, y);
 }
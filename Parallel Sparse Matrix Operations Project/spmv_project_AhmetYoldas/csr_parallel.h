@@ -21,4 +21,13 @@
  */
 void spmv_csr_parallel(const CSR_Matrix *A, const double *x, double *y);
 
+/**
+ * CSR Parallel y = α·A·x + β·y
+ * 
+ * α and β are applied in the same store that writes each row sum,
+ * so solvers need no extra scaling/axpy pass over y.
+ */
+void spmv_csr_parallel_mv(double alpha, const CSR_Matrix *A, const double *x,
+                          double beta, double *y);
+
 #endif // CSR_PARALLEL_H
@@ -4,12 +4,27 @@
 
 #include "csr_serial.h"
 
+// One instantiation per α/β mode (see MV_MODE_LIST)
+#define DEFINE_CSR_SERIAL_MV(MODE, STORE)                                   \
+static void csr_serial_mv_##MODE(double alpha, const CSR_Matrix *A,         \
+                                 const double *x, double beta, double *y) { \
+    (void)alpha; (void)beta;                                                \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum += A->values[k] * x[A->col_idx[k]];                         \
+        }                                                                   \
+        STORE(y[i], sum, alpha, beta);                                      \
+    }                                                                       \
+}
+
+MV_MODE_LIST(DEFINE_CSR_SERIAL_MV)
+
 void spmv_csr_serial(const CSR_Matrix *A, const double *x, double *y) {
-    for (int i = 0; i < A->rows; i++) {
-        double sum = 0.0;
-        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {
-            sum += A->values[k] * x[A->col_idx[k]];
-        }
-        y[i] = sum;
-    }
+    csr_serial_mv_a1_b0(1.0, A, x, 0.0, y);
+}
+
+void spmv_csr_serial_mv(double alpha, const CSR_Matrix *A, const double *x,
+                        double beta, double *y) {
+    MV_DISPATCH(csr_serial_mv, alpha, A, x, beta, y);
 }
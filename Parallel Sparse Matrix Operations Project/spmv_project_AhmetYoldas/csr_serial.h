@@ -20,4 +20,13 @@
  */
 void spmv_csr_serial(const CSR_Matrix *A, const double *x, double *y);
 
+/**
+ * CSR Serial y = α·A·x + β·y (Sparse BLAS mv)
+ * 
+ * Reference for the parallel *_mv kernels. α/β cases are dispatched
+ * to separate instantiations (MV_MODE_LIST in common.h).
+ */
+void spmv_csr_serial_mv(double alpha, const CSR_Matrix *A, const double *x,
+                        double beta, double *y);
+
 #endif // CSR_SERIAL_H
@@ -0,0 +1,169 @@
+/**
+ * CSR-DU Parallel Implementation
+ */
+
+#include "csrdu_parallel.h"
+#include <omp.h>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+static const int csrdu_unit_bytes[3] = {1, 2, 4};
+
+#if defined(__AVX2__) && defined(__FMA__)
+// Inclusive prefix sum of 8 int32 lanes plus base (all lanes), mod 2^32
+static inline __m256i csrdu_prefix8(__m256i d, __m256i base) {
+    d = _mm256_add_epi32(d, _mm256_slli_si256(d, 4));
+    d = _mm256_add_epi32(d, _mm256_slli_si256(d, 8));
+    // Carry the low 128-bit half's total into the high half
+    __m256i lo_total = _mm256_shuffle_epi32(d, 0xFF);
+    d = _mm256_add_epi32(d, _mm256_permute2x128_si256(lo_total, lo_total, 0x08));
+    return _mm256_add_epi32(d, base);
+}
+
+static inline double csrdu_hsum(__m256d a, __m256d b) {
+    __m256d s = _mm256_add_pd(a, b);
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+// One group of rows. Each step widens 8 deltas to int32, prefix-sums
+// them in registers and gathers x with the result; the last step of a
+// unit is masked. Deltas past the unit are read (CSRDU_PAD) but unused.
+static void csrdu_group(const CSRDU_Matrix *A, int g, const double *x, double *y) {
+    const uint8_t *p = A->ctl + A->grp_ctl[g];
+    const uint8_t *end = A->ctl + A->grp_ctl[g + 1];
+    const double *val = A->values + A->grp_val[g];
+    const int row_begin = g * CSRDU_GROUP;
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int i = row_begin - 1;               // Row being accumulated
+    __m256i col = _mm256_setzero_si256();
+    __m256i first = _mm256_setzero_si256();
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    
+    while (p < end) {
+        int header = *p++;
+        int width = header & 3;
+        int count = ((header >> 2) & 31) + 1;
+        int new_row = header & CSRDU_NEW_ROW;
+        
+        if (new_row) {
+            if (i >= row_begin) y[i] = csrdu_hsum(acc0, acc1);
+            acc0 = acc1 = _mm256_setzero_pd();
+            if (width == CSRDU_EMPTY) {
+                // count empty rows; the last is stored by the next flush
+                for (int r = i + 1; r < i + count; r++) y[r] = 0.0;
+                i += count;
+                continue;
+            }
+            i++;
+            col = first;
+        }
+        
+        for (int j = 0; j < count; j += 8) {
+            __m256i d;
+            if (width == CSRDU_U8) {
+                d = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(p + j)));
+            } else if (width == CSRDU_U16) {
+                d = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(p + 2 * j)));
+            } else {
+                d = _mm256_loadu_si256((const __m256i*)(p + 4 * j));
+            }
+            __m256i c = csrdu_prefix8(d, col);
+            __m128i c0 = _mm256_castsi256_si128(c);
+            __m128i c1 = _mm256_extracti128_si256(c, 1);
+            int left = count - j;
+            
+            if (new_row && j == 0) first = _mm256_permutevar8x32_epi32(c, _mm256_setzero_si256());
+            col = _mm256_permutevar8x32_epi32(c, _mm256_set1_epi32(left >= 8 ? 7 : left - 1));
+            
+            if (left >= 8) {
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(val + j),
+                                       _mm256_i32gather_pd(x, c0, 8), acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(val + j + 4),
+                                       _mm256_i32gather_pd(x, c1, 8), acc1);
+            } else {
+                __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32(left), lane);
+                __m256d m0 = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(m)));
+                acc0 = _mm256_fmadd_pd(_mm256_maskload_pd(val + j, _mm256_castpd_si256(m0)),
+                                       _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, c0, m0, 8),
+                                       acc0);
+                if (left > 4) {
+                    __m256d m1 = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(m, 1)));
+                    acc1 = _mm256_fmadd_pd(_mm256_maskload_pd(val + j + 4, _mm256_castpd_si256(m1)),
+                                           _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, c1, m1, 8),
+                                           acc1);
+                }
+            }
+        }
+        p += count * csrdu_unit_bytes[width];
+        val += count;
+    }
+    
+    if (i >= row_begin) y[i] = csrdu_hsum(acc0, acc1);
+}
+#else
+// One group of rows: decode a unit into cols[], then multiply
+static void csrdu_group(const CSRDU_Matrix *A, int g, const double *x, double *y) {
+    const uint8_t *p = A->ctl + A->grp_ctl[g];
+    const uint8_t *end = A->ctl + A->grp_ctl[g + 1];
+    const double *val = A->values + A->grp_val[g];
+    const int row_begin = g * CSRDU_GROUP;
+    int i = row_begin - 1;               // Row being accumulated
+    unsigned int col = 0, first = 0;
+    double sum = 0.0;
+    
+    int cols[CSRDU_MAX_UNIT];
+    
+    while (p < end) {
+        int header = *p++;
+        int width = header & 3;
+        int count = ((header >> 2) & 31) + 1;
+        
+        if (header & CSRDU_NEW_ROW) {
+            if (i >= row_begin) y[i] = sum;
+            sum = 0.0;
+            if (width == CSRDU_EMPTY) {
+                for (int r = i + 1; r < i + count; r++) y[r] = 0.0;
+                i += count;
+                continue;
+            }
+            i++;
+            col = first;
+        }
+        
+        // Decode one unit: prefix sum of deltas
+        for (int j = 0; j < count; j++) {
+            if (width == CSRDU_U8) {
+                col += p[j];
+            } else if (width == CSRDU_U16) {
+                uint16_t d;
+                memcpy(&d, p + 2 * j, sizeof(d));
+                col += d;
+            } else {
+                uint32_t d;
+                memcpy(&d, p + 4 * j, sizeof(d));
+                col += d;
+            }
+            cols[j] = (int)col;
+        }
+        if (header & CSRDU_NEW_ROW) first = (unsigned int)cols[0];
+        p += count * csrdu_unit_bytes[width];
+        
+        // Multiply: no dependency between iterations except the sum
+        for (int j = 0; j < count; j++) {
+            sum += val[j] * x[cols[j]];
+        }
+        val += count;
+    }
+    
+    if (i >= row_begin) y[i] = sum;
+}
+#endif
+
+void spmv_csrdu_parallel(const CSRDU_Matrix *A, const double *x, double *y) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int g = 0; g < A->num_groups; g++) {
+        csrdu_group(A, g, x, y);
+    }
+}
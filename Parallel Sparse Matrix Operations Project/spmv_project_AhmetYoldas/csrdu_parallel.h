@@ -0,0 +1,27 @@
+/**
+ * CSR-DU Parallel
+ * Delta-encoded column indices, decoded on the fly
+ */
+
+#ifndef CSRDU_PARALLEL_H
+#define CSRDU_PARALLEL_H
+
+#include "common.h"
+
+/**
+ * CSR-DU Parallel SpMV
+ * 
+ * Optimizations:
+ * - Column indices stored as 8/16-bit deltas (32-bit escape units)
+ * - ~1 byte per column instead of 4 on clustered rows, and no
+ *   per-row pointers (rows are found by the NEW_ROW flag)
+ * - Decode widens 8 deltas to int32, prefix-sums them in registers
+ *   and gathers x with the result (AVX2); scalar decode otherwise
+ * - OpenMP dynamic scheduling, one CSRDU_GROUP of rows per task
+ * 
+ * Expected: faster than CSR Parallel when memory-bound
+ * (fewer bytes per nonzero), similar when compute-bound
+ */
+void spmv_csrdu_parallel(const CSRDU_Matrix *A, const double *x, double *y);
+
+#endif // CSRDU_PARALLEL_H
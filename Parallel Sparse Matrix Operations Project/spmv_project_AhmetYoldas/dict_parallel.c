@@ -0,0 +1,28 @@
+/**
+ * Dictionary-Compressed SpMV Implementation
+ */
+
+#include "dict_parallel.h"
+#include <omp.h>
+
+#define DEFINE_CSR_DICT_KERNEL(TAG, CODE_T)                                 \
+static void csr_dict_##TAG(const CSR_Dict_Matrix *A, const double *x, double *y) { \
+    const CODE_T *codes = (const CODE_T*)A->codes;                          \
+    const double *table = A->table;                                         \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum += table[codes[k]] * x[A->col_idx[k]];                      \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}
+
+DEFINE_CSR_DICT_KERNEL(u8, uint8_t)
+DEFINE_CSR_DICT_KERNEL(u16, uint16_t)
+
+void spmv_csr_dict_parallel(const CSR_Dict_Matrix *A, const double *x, double *y) {
+    if (A->code_bytes == 1) csr_dict_u8(A, x, y);
+    else csr_dict_u16(A, x, y);
+}
@@ -0,0 +1,310 @@
+/**
+ * Distributed-Memory SpMV Implementation (MPI + OpenMP)
+ */
+
+#include "dist_spmv.h"
+#include <omp.h>
+
+// ============================================
+// Row Partition + Scatter
+// ============================================
+
+void dist_row_partition(int rows, int size, int *row_starts) {
+    int base = rows / size;
+    int extra = rows % size;
+    
+    row_starts[0] = 0;
+    for (int r = 0; r < size; r++) {
+        row_starts[r + 1] = row_starts[r] + base + (r < extra ? 1 : 0);
+    }
+}
+
+CSR_Matrix* dist_scatter_rows(const CSR_Matrix *A_root, const int *row_starts,
+                              int root, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    
+    int local_rows = row_starts[rank + 1] - row_starts[rank];
+    int cols = (rank == root) ? A_root->cols : 0;
+    MPI_Bcast(&cols, 1, MPI_INT, root, comm);
+    
+    int *row_counts = NULL, *row_displs = NULL;
+    int *nnz_counts = NULL, *nnz_displs = NULL;
+    
+    if (rank == root) {
+        row_counts = (int*)malloc(size * sizeof(int));
+        row_displs = (int*)malloc(size * sizeof(int));
+        nnz_counts = (int*)malloc(size * sizeof(int));
+        nnz_displs = (int*)malloc(size * sizeof(int));
+        
+        for (int r = 0; r < size; r++) {
+            row_counts[r] = row_starts[r + 1] - row_starts[r];
+            row_displs[r] = row_starts[r];
+            nnz_displs[r] = A_root->row_ptr[row_starts[r]];
+            nnz_counts[r] = A_root->row_ptr[row_starts[r + 1]] - nnz_displs[r];
+        }
+    }
+    
+    int local_nnz;
+    MPI_Scatter(nnz_counts, 1, MPI_INT, &local_nnz, 1, MPI_INT, root, comm);
+    
+    CSR_Matrix *S = csr_alloc(local_rows, cols, local_nnz);
+    
+    // row_ptr: scatter the first local_rows entries, then rebase
+    MPI_Scatterv(rank == root ? A_root->row_ptr : NULL, row_counts, row_displs, MPI_INT,
+                 S->row_ptr, local_rows, MPI_INT, root, comm);
+    int base = (local_rows > 0) ? S->row_ptr[0] : 0;
+    for (int i = 0; i < local_rows; i++) {
+        S->row_ptr[i] -= base;
+    }
+    S->row_ptr[local_rows] = local_nnz;
+    
+    MPI_Scatterv(rank == root ? A_root->col_idx : NULL, nnz_counts, nnz_displs, MPI_INT,
+                 S->col_idx, local_nnz, MPI_INT, root, comm);
+    MPI_Scatterv(rank == root ? A_root->values : NULL, nnz_counts, nnz_displs, MPI_DOUBLE,
+                 S->values, local_nnz, MPI_DOUBLE, root, comm);
+    
+    free(row_counts);
+    free(row_displs);
+    free(nnz_counts);
+    free(nnz_displs);
+    return S;
+}
+
+// ============================================
+// Setup Phase
+// ============================================
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Rank owning global row/column g
+static int owner_of(const int *row_starts, int size, int g) {
+    int lo = 0, hi = size - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (row_starts[mid] <= g) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// Position of g in sorted array a[0..n)
+static int find_sorted(const int *a, int n, int g) {
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (a[mid] < g) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+Dist_CSR* dist_csr_create(const CSR_Matrix *A_slab, const int *row_starts,
+                          int global_cols, MPI_Comm comm) {
+    Dist_CSR *D = (Dist_CSR*)calloc(1, sizeof(Dist_CSR));
+    
+    D->comm = comm;
+    MPI_Comm_rank(comm, &D->rank);
+    MPI_Comm_size(comm, &D->size);
+    D->global_rows = row_starts[D->size];
+    D->global_cols = global_cols;
+    D->row_starts = (int*)malloc((D->size + 1) * sizeof(int));
+    memcpy(D->row_starts, row_starts, (D->size + 1) * sizeof(int));
+    D->row_start = row_starts[D->rank];
+    D->local_rows = row_starts[D->rank + 1] - D->row_start;
+    
+    int row_start = D->row_start;
+    int row_end = row_start + D->local_rows;
+    int nnz = A_slab->nnz;
+    
+    // ----- 1. Ghost columns (sorted, unique) -----
+    int *ghosts = (int*)malloc((nnz + 1) * sizeof(int));
+    int num_ghosts = 0;
+    for (int k = 0; k < nnz; k++) {
+        int col = A_slab->col_idx[k];
+        if (col < row_start || col >= row_end) ghosts[num_ghosts++] = col;
+    }
+    qsort(ghosts, num_ghosts, sizeof(int), compare_int);
+    int unique = 0;
+    for (int g = 0; g < num_ghosts; g++) {
+        if (unique == 0 || ghosts[g] != ghosts[unique - 1]) ghosts[unique++] = ghosts[g];
+    }
+    D->num_ghosts = unique;
+    D->ghost_cols = ghosts;
+    D->x_ghost = (double*)malloc((unique + 1) * sizeof(double));
+    
+    // ----- 2. Recv lists (ghosts are sorted, so owners are contiguous) -----
+    int *need = (int*)calloc(D->size, sizeof(int));
+    for (int g = 0; g < unique; g++) {
+        need[owner_of(row_starts, D->size, ghosts[g])]++;
+    }
+    
+    D->recv_ranks = (int*)malloc(D->size * sizeof(int));
+    D->recv_counts = (int*)malloc(D->size * sizeof(int));
+    D->recv_displs = (int*)malloc(D->size * sizeof(int));
+    int *need_displs = (int*)malloc(D->size * sizeof(int));
+    int offset = 0;
+    for (int r = 0; r < D->size; r++) {
+        need_displs[r] = offset;
+        if (need[r] > 0) {
+            D->recv_ranks[D->num_recv] = r;
+            D->recv_counts[D->num_recv] = need[r];
+            D->recv_displs[D->num_recv] = offset;
+            D->num_recv++;
+        }
+        offset += need[r];
+    }
+    
+    // ----- 3. Send lists: tell each owner which entries we need -----
+    int *give = (int*)malloc(D->size * sizeof(int));
+    MPI_Alltoall(need, 1, MPI_INT, give, 1, MPI_INT, comm);
+    
+    int *give_displs = (int*)malloc(D->size * sizeof(int));
+    int send_total = 0;
+    for (int r = 0; r < D->size; r++) {
+        give_displs[r] = send_total;
+        send_total += give[r];
+    }
+    
+    D->send_idx = (int*)malloc((send_total + 1) * sizeof(int));
+    D->send_buf = (double*)malloc((send_total + 1) * sizeof(double));
+    MPI_Alltoallv(ghosts, need, need_displs, MPI_INT,
+                  D->send_idx, give, give_displs, MPI_INT, comm);
+    for (int k = 0; k < send_total; k++) {
+        D->send_idx[k] -= row_start;
+    }
+    
+    D->send_ranks = (int*)malloc(D->size * sizeof(int));
+    D->send_counts = (int*)malloc(D->size * sizeof(int));
+    D->send_displs = (int*)malloc(D->size * sizeof(int));
+    for (int r = 0; r < D->size; r++) {
+        if (give[r] > 0) {
+            D->send_ranks[D->num_send] = r;
+            D->send_counts[D->num_send] = give[r];
+            D->send_displs[D->num_send] = give_displs[r];
+            D->num_send++;
+        }
+    }
+    
+    D->requests = (MPI_Request*)malloc((D->num_recv + D->num_send + 1) * sizeof(MPI_Request));
+    
+    // ----- 4. Split slab into diagonal / off-diagonal blocks -----
+    int local_nnz = 0;
+    for (int k = 0; k < nnz; k++) {
+        int col = A_slab->col_idx[k];
+        if (col >= row_start && col < row_end) local_nnz++;
+    }
+    
+    D->A_local = csr_alloc(D->local_rows, D->local_rows, local_nnz);
+    D->A_ghost = csr_alloc(D->local_rows, unique, nnz - local_nnz);
+    
+    int kl = 0, kg = 0;
+    for (int i = 0; i < D->local_rows; i++) {
+        for (int k = A_slab->row_ptr[i]; k < A_slab->row_ptr[i + 1]; k++) {
+            int col = A_slab->col_idx[k];
+            if (col >= row_start && col < row_end) {
+                D->A_local->col_idx[kl] = col - row_start;
+                D->A_local->values[kl] = A_slab->values[k];
+                kl++;
+            } else {
+                D->A_ghost->col_idx[kg] = find_sorted(ghosts, unique, col);
+                D->A_ghost->values[kg] = A_slab->values[k];
+                kg++;
+            }
+        }
+        D->A_local->row_ptr[i + 1] = kl;
+        D->A_ghost->row_ptr[i + 1] = kg;
+    }
+    
+    free(need);
+    free(need_displs);
+    free(give);
+    free(give_displs);
+    return D;
+}
+
+// ============================================
+// Execute Phase
+// ============================================
+
+void dist_spmv(Dist_CSR *D, const double *x_local, double *y_local, Dist_Stats *stats) {
+    double t0 = MPI_Wtime();
+    
+    // 1. Start halo exchange
+    for (int r = 0; r < D->num_recv; r++) {
+        MPI_Irecv(D->x_ghost + D->recv_displs[r], D->recv_counts[r], MPI_DOUBLE,
+                  D->recv_ranks[r], 0, D->comm, &D->requests[r]);
+    }
+    
+    int send_total = (D->num_send > 0) ?
+                     D->send_displs[D->num_send - 1] + D->send_counts[D->num_send - 1] : 0;
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < send_total; k++) {
+        D->send_buf[k] = x_local[D->send_idx[k]];
+    }
+    
+    for (int s = 0; s < D->num_send; s++) {
+        MPI_Isend(D->send_buf + D->send_displs[s], D->send_counts[s], MPI_DOUBLE,
+                  D->send_ranks[s], 0, D->comm, &D->requests[D->num_recv + s]);
+    }
+    
+    // 2. Local diagonal block while messages are in flight
+    const CSR_Matrix *L = D->A_local;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < L->rows; i++) {
+        double sum = 0.0;
+        for (int k = L->row_ptr[i]; k < L->row_ptr[i+1]; k++) {
+            sum += L->values[k] * x_local[L->col_idx[k]];
+        }
+        y_local[i] = sum;
+    }
+    double t1 = MPI_Wtime();
+    
+    // 3. Wait for ghosts
+    MPI_Waitall(D->num_recv + D->num_send, D->requests, MPI_STATUSES_IGNORE);
+    double t2 = MPI_Wtime();
+    
+    // 4. Off-diagonal block
+    const CSR_Matrix *G = D->A_ghost;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < G->rows; i++) {
+        double sum = 0.0;
+        for (int k = G->row_ptr[i]; k < G->row_ptr[i+1]; k++) {
+            sum += G->values[k] * D->x_ghost[G->col_idx[k]];
+        }
+        y_local[i] += sum;
+    }
+    double t3 = MPI_Wtime();
+    
+    if (stats) {
+        stats->total_time = t3 - t0;
+        stats->local_time = t1 - t0;
+        stats->wait_time = t2 - t1;
+        stats->ghost_time = t3 - t2;
+    }
+}
+
+void dist_csr_free(Dist_CSR *D) {
+    if (D) {
+        csr_free(D->A_local);
+        csr_free(D->A_ghost);
+        free(D->row_starts);
+        free(D->ghost_cols);
+        free(D->x_ghost);
+        free(D->recv_ranks);
+        free(D->recv_counts);
+        free(D->recv_displs);
+        free(D->send_ranks);
+        free(D->send_counts);
+        free(D->send_displs);
+        free(D->send_idx);
+        free(D->send_buf);
+        free(D->requests);
+        free(D);
+    }
+}
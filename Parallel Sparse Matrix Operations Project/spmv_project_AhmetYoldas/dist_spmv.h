@@ -0,0 +1,101 @@
+/**
+ * Distributed-Memory SpMV (MPI + OpenMP)
+ * Row-distributed CSR with ghost-column halo exchange
+ */
+
+#ifndef DIST_SPMV_H
+#define DIST_SPMV_H
+
+#include "common.h"
+#include <mpi.h>
+
+// ============================================
+// Distributed CSR (one per rank)
+// ============================================
+// Rank r owns rows [row_starts[r], row_starts[r+1]) of A and the same
+// range of x and y (A must be square). Local rows are split into two CSR blocks:
+// - A_local: columns owned by this rank (local column ids)
+// - A_ghost: columns owned by other ranks (ids into x_ghost)
+typedef struct {
+    MPI_Comm comm;
+    int rank;
+    int size;
+    int global_rows;
+    int global_cols;
+    int *row_starts;          // Size: size+1 (same on every rank)
+    int row_start;
+    int local_rows;
+    
+    CSR_Matrix *A_local;      // local_rows × local_rows
+    CSR_Matrix *A_ghost;      // local_rows × num_ghosts
+    
+    int num_ghosts;
+    int *ghost_cols;          // Size: num_ghosts (global ids, sorted)
+    double *x_ghost;          // Size: num_ghosts
+    
+    // Receive list: ghosts grouped by owner rank
+    int num_recv;
+    int *recv_ranks;
+    int *recv_counts;
+    int *recv_displs;         // Offsets into x_ghost
+    
+    // Send list: local x entries other ranks need
+    int num_send;
+    int *send_ranks;
+    int *send_counts;
+    int *send_displs;         // Offsets into send_idx / send_buf
+    int *send_idx;            // Local row ids to pack
+    double *send_buf;
+    
+    MPI_Request *requests;    // Size: num_recv + num_send
+} Dist_CSR;
+
+// Timing breakdown of one distributed SpMV
+typedef struct {
+    double total_time;        // Whole SpMV (sec)
+    double local_time;        // Diagonal block, overlapped with halo
+    double wait_time;         // MPI_Waitall after local compute
+    double ghost_time;        // Off-diagonal block
+} Dist_Stats;
+
+/**
+ * Even contiguous row partition: rank r gets rows/size rows,
+ * the first rows%size ranks get one extra. row_starts: size+1
+ */
+void dist_row_partition(int rows, int size, int *row_starts);
+
+/**
+ * Scatter row slabs of a root matrix (global column ids kept).
+ * A_root is only read on root; every rank gets its slab.
+ */
+CSR_Matrix* dist_scatter_rows(const CSR_Matrix *A_root, const int *row_starts,
+                              int root, MPI_Comm comm);
+
+/**
+ * Setup phase (collective)
+ * 
+ * - Find ghost columns of the local slab
+ * - Build recv lists (ghosts grouped by owner)
+ * - Exchange requests (MPI_Alltoall/Alltoallv) to build send lists
+ * - Split the slab into A_local / A_ghost with renumbered columns
+ */
+Dist_CSR* dist_csr_create(const CSR_Matrix *A_slab, const int *row_starts,
+                          int global_cols, MPI_Comm comm);
+
+/**
+ * Execute phase: y_local = A x (collective)
+ * 
+ * 1. Post MPI_Irecv for ghosts, pack + MPI_Isend owned entries
+ * 2. y = A_local · x_local   (OpenMP, overlaps the halo exchange)
+ * 3. MPI_Waitall
+ * 4. y += A_ghost · x_ghost  (OpenMP)
+ * 
+ * MPI is only called from the master thread (MPI_THREAD_FUNNELED).
+ * stats may be NULL.
+ */
+void dist_spmv(Dist_CSR *D, const double *x_local, double *y_local, Dist_Stats *stats);
+
+// Free distributed matrix
+void dist_csr_free(Dist_CSR *D);
+
+#endif // DIST_SPMV_H
@@ -0,0 +1,72 @@
+/**
+ * Merge-Path SpMV Implementation
+ */
+
+#include "merge_parallel.h"
+#include <omp.h>
+
+// Find the merge-path coordinate (row, k) on diagonal diag
+static void merge_path_search(const CSR_Matrix *A, int64_t diag, int *row, int *k) {
+    const int *row_end = A->row_ptr + 1;
+    int64_t lo = (diag - A->nnz > 0) ? diag - A->nnz : 0;
+    int64_t hi = (diag < A->rows) ? diag : A->rows;
+    
+    while (lo < hi) {
+        int64_t pivot = (lo + hi) / 2;
+        if (row_end[pivot] <= diag - pivot - 1) lo = pivot + 1;
+        else hi = pivot;
+    }
+    *row = (int)lo;
+    *k = (int)(diag - lo);
+}
+
+void spmv_merge_parallel(const CSR_Matrix *A, const double *x, double *y) {
+    int max_threads = omp_get_max_threads();
+    int *carry_row = (int*)malloc(max_threads * sizeof(int));
+    double *carry_val = (double*)malloc(max_threads * sizeof(double));
+    int num_threads = 1;
+    
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        #pragma omp single
+        num_threads = nt;
+        
+        int64_t total = (int64_t)A->rows + A->nnz;
+        int64_t per_thread = (total + nt - 1) / nt;
+        int64_t diag0 = (per_thread * tid < total) ? per_thread * tid : total;
+        int64_t diag1 = (diag0 + per_thread < total) ? diag0 + per_thread : total;
+        
+        int row, k, row_end, k_end;
+        merge_path_search(A, diag0, &row, &k);
+        merge_path_search(A, diag1, &row_end, &k_end);
+        
+        // Rows finished inside this thread's range
+        for (; row < row_end; row++) {
+            double sum = 0.0;
+            for (; k < A->row_ptr[row + 1]; k++) {
+                sum += A->values[k] * x[A->col_idx[k]];
+            }
+            y[row] = sum;
+        }
+        
+        // Partial sum of the row this thread stops in
+        double sum = 0.0;
+        for (; k < k_end; k++) {
+            sum += A->values[k] * x[A->col_idx[k]];
+        }
+        carry_row[tid] = row_end;
+        carry_val[tid] = sum;
+    }
+    
+    // Fix up rows split between threads
+    for (int t = 0; t < num_threads - 1; t++) {
+        if (carry_row[t] < A->rows) {
+            y[carry_row[t]] += carry_val[t];
+        }
+    }
+    
+    free(carry_row);
+    free(carry_val);
+}
@@ -0,0 +1,24 @@
+/**
+ * Merge-Path SpMV
+ * Equal (rows + nnz) work per thread
+ */
+
+#ifndef MERGE_PARALLEL_H
+#define MERGE_PARALLEL_H
+
+#include "common.h"
+
+/**
+ * Merge-based CSR SpMV: y = A·x
+ * 
+ * SpMV is treated as a merge of the row_ptr list with the nnz list.
+ * Each thread takes an equal share of the (rows + nnz) merge path,
+ * found by binary search on its diagonal, so a long row is split
+ * between threads and runs of empty rows still count as work. The
+ * partial sum of the row each thread stops in is fixed up serially.
+ * 
+ * Uses plain CSR_Matrix (no preprocessing).
+ */
+void spmv_merge_parallel(const CSR_Matrix *A, const double *x, double *y);
+
+#endif // MERGE_PARALLEL_H
@@ -0,0 +1,79 @@
+/**
+ * Mixed-Precision SpMV Implementation
+ */
+
+#include "mixed_precision.h"
+#include <omp.h>
+
+#define LOAD_F32(v)  ((double)(v))
+#define LOAD_BF16(v) ((double)bf16_to_float(v))
+#define LOAD_F16(v)  ((double)half_to_float(v))
+
+// ============================================
+// CSR kernels (one per value type)
+// ============================================
+#define DEFINE_CSR_MP_KERNEL(TAG, VAL_T, LOAD)                              \
+static void csr_mp_##TAG(const CSR_MP_Matrix *A, const double *x, double *y) { \
+    const VAL_T *val = (const VAL_T*)A->values;                             \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = 0.0;                                                   \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum += LOAD(val[k]) * x[A->col_idx[k]];                         \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}
+
+DEFINE_CSR_MP_KERNEL(f32, float, LOAD_F32)
+DEFINE_CSR_MP_KERNEL(bf16, uint16_t, LOAD_BF16)
+DEFINE_CSR_MP_KERNEL(f16, uint16_t, LOAD_F16)
+
+void spmv_csr_mp_parallel(const CSR_MP_Matrix *A, const double *x, double *y) {
+    if (A->value_type == VALUE_F32) csr_mp_f32(A, x, y);
+    else if (A->value_type == VALUE_BF16) csr_mp_bf16(A, x, y);
+    else csr_mp_f16(A, x, y);
+}
+
+// ============================================
+// BCSR kernels (one per value type)
+// ============================================
+#define DEFINE_BCSR_MP_KERNEL(TAG, VAL_T, LOAD)                             \
+static void bcsr_mp_##TAG(const BCSR_MP_Matrix *A, const double *x, double *y) { \
+    const VAL_T *val = (const VAL_T*)A->block_val;                          \
+    memset(y, 0, A->rows * sizeof(double));                                 \
+                                                                            \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int br = 0; br < A->block_rows; br++) {                            \
+        int row_start = br * 4;                                             \
+                                                                            \
+        for (int kb = A->block_row_ptr[br]; kb < A->block_row_ptr[br + 1]; kb++) { \
+            int col_start = A->block_col_idx[kb] * 4;                       \
+            const VAL_T *block = &val[(size_t)kb * 16];                     \
+                                                                            \
+            double xv[4];                                                   \
+            for (int j = 0; j < 4; j++) {                                   \
+                xv[j] = (col_start + j < A->cols) ? x[col_start + j] : 0.0; \
+            }                                                               \
+                                                                            \
+            for (int i = 0; i < 4; i++) {                                   \
+                if (row_start + i < A->rows) {                              \
+                    y[row_start + i] += LOAD(block[i * 4 + 0]) * xv[0] +    \
+                                        LOAD(block[i * 4 + 1]) * xv[1] +    \
+                                        LOAD(block[i * 4 + 2]) * xv[2] +    \
+                                        LOAD(block[i * 4 + 3]) * xv[3];     \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+}
+
+DEFINE_BCSR_MP_KERNEL(f32, float, LOAD_F32)
+DEFINE_BCSR_MP_KERNEL(bf16, uint16_t, LOAD_BF16)
+DEFINE_BCSR_MP_KERNEL(f16, uint16_t, LOAD_F16)
+
+void spmv_bcsr_mp_parallel(const BCSR_MP_Matrix *A, const double *x, double *y) {
+    if (A->value_type == VALUE_F32) bcsr_mp_f32(A, x, y);
+    else if (A->value_type == VALUE_BF16) bcsr_mp_bf16(A, x, y);
+    else bcsr_mp_f16(A, x, y);
+}
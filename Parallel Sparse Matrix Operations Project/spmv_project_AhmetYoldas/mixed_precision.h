@@ -0,0 +1,32 @@
+/**
+ * Mixed-Precision SpMV
+ * float / bfloat16 / half values, double accumulation
+ */
+
+#ifndef MIXED_PRECISION_H
+#define MIXED_PRECISION_H
+
+#include "common.h"
+
+/**
+ * CSR Parallel SpMV with reduced-precision values
+ * 
+ * Optimizations:
+ * - Values stored as float (4 B) or bf16/fp16 (2 B) instead of 8 B
+ * - Convert on load (F16C vcvtph2ps for half), accumulate in double
+ * - One inlined loop per value type (no per-element dispatch)
+ * - OpenMP dynamic scheduling (chunk size 64), same as Method 2
+ * 
+ * Bytes per nnz: 8 (float), 6 (bf16/fp16) vs 12 for double CSR
+ */
+void spmv_csr_mp_parallel(const CSR_MP_Matrix *A, const double *x, double *y);
+
+/**
+ * BCSR Parallel SpMV (4×4) with reduced-precision values
+ * 
+ * Same structure as Method 3; each block is converted to double
+ * in registers before the unrolled 4×4 multiply.
+ */
+void spmv_bcsr_mp_parallel(const BCSR_MP_Matrix *A, const double *x, double *y);
+
+#endif // MIXED_PRECISION_H
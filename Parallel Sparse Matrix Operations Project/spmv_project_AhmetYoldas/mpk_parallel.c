@@ -0,0 +1,116 @@
+/**
+ * Matrix-Powers Kernel Implementation
+ */
+
+#include "mpk_parallel.h"
+#include <omp.h>
+
+MPK_Plan* mpk_plan_create(const CSR_Matrix *A, int k, int bucket_rows) {
+    // Level j-1 feeds level j, so columns must index rows
+    if (A->rows != A->cols) return NULL;
+    
+    MPK_Plan *P = (MPK_Plan*)malloc(sizeof(MPK_Plan));
+    int n = A->rows;
+    
+    if (bucket_rows <= 0) {
+        // k levels of a bucket (values + col_idx) should fit the budget
+        double row_bytes = (A->nnz / (double)(n > 0 ? n : 1)) *
+                           (sizeof(double) + sizeof(int)) + sizeof(int);
+        bucket_rows = (int)(MPK_CACHE_BYTES / (k * row_bytes));
+        if (bucket_rows < 64) bucket_rows = 64;
+    }
+    
+    P->k = k;
+    P->rows = n;
+    P->bucket_rows = bucket_rows;
+    
+    // Prefix maximum of each row's largest column
+    int *pm = (int*)malloc((n + 1) * sizeof(int));
+    int running = -1;
+    for (int i = 0; i < n; i++) {
+        for (int q = A->row_ptr[i]; q < A->row_ptr[i + 1]; q++) {
+            if (A->col_idx[q] > running) running = A->col_idx[q];
+        }
+        pm[i] = running;
+    }
+    
+    // Steps until every level reaches n (at most n/bucket + k)
+    int max_steps = (n + bucket_rows - 1) / bucket_rows + k + 1;
+    P->level_end = (int*)malloc((size_t)max_steps * k * sizeof(int));
+    int *done = (int*)calloc(k + 1, sizeof(int));   // done[j]: rows of level j
+    
+    P->num_steps = 0;
+    P->traffic_nnz = 0;
+    while (done[k] < n) {
+        long long level_nnz = 0;
+        int window_lo = n;
+        
+        done[1] = (done[1] + bucket_rows < n) ? done[1] + bucket_rows : n;
+        for (int j = 2; j <= k; j++) {
+            // First row at or after done[j] whose prefix needs columns
+            // not yet done at level j-1 (pm is non-decreasing)
+            int limit = done[j - 1];
+            int lo = done[j], hi = done[j - 1];
+            while (lo < hi) {
+                int mid = lo + (hi - lo) / 2;
+                if (pm[mid] < limit) lo = mid + 1;
+                else hi = mid;
+            }
+            done[j] = lo;
+        }
+        
+        for (int j = 1; j <= k; j++) {
+            int prev = (P->num_steps > 0) ?
+                       P->level_end[(size_t)(P->num_steps - 1) * k + (j - 1)] : 0;
+            if (done[j] > prev) {
+                level_nnz += A->row_ptr[done[j]] - A->row_ptr[prev];
+                if (prev < window_lo) window_lo = prev;
+            }
+            P->level_end[(size_t)P->num_steps * k + (j - 1)] = done[j];
+        }
+        
+        // Rows of the window stay cached across levels only if it fits
+        long long window_nnz = (window_lo < done[1]) ?
+                               A->row_ptr[done[1]] - A->row_ptr[window_lo] : 0;
+        double window_bytes = window_nnz * (double)(sizeof(double) + sizeof(int));
+        P->traffic_nnz += (window_bytes <= MPK_CACHE_BYTES) ? window_nnz : level_nnz;
+        P->num_steps++;
+    }
+    
+    free(done);
+    free(pm);
+    return P;
+}
+
+void mpk_plan_free(MPK_Plan *P) {
+    if (P) {
+        free(P->level_end);
+        free(P);
+    }
+}
+
+void spmv_mpk_parallel(const CSR_Matrix *A, const MPK_Plan *P, const double *x, double *V) {
+    const int k = P->k;
+    const int n = A->rows;
+    
+    #pragma omp parallel
+    for (int s = 0; s < P->num_steps; s++) {
+        for (int j = 1; j <= k; j++) {
+            int lo = (s > 0) ? P->level_end[(size_t)(s - 1) * k + (j - 1)] : 0;
+            int hi = P->level_end[(size_t)s * k + (j - 1)];
+            const double *in = (j == 1) ? x : V + (size_t)(j - 2) * n;
+            double *out = V + (size_t)(j - 1) * n;
+            
+            // Static slices: a thread's rows at level j are about the rows
+            // it produced at level j-1, and no chunk is fetched per 64 rows
+            #pragma omp for schedule(static)
+            for (int i = lo; i < hi; i++) {
+                double sum = 0.0;
+                for (int q = A->row_ptr[i]; q < A->row_ptr[i + 1]; q++) {
+                    sum += A->values[q] * in[A->col_idx[q]];
+                }
+                out[i] = sum;
+            }
+        }
+    }
+}
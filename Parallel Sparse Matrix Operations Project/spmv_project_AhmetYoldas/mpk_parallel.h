@@ -0,0 +1,60 @@
+/**
+ * Matrix-Powers Kernel (MPK)
+ * Cache-blocked [A·x, A²·x, …, Aᵏ·x] on CSR
+ */
+
+#ifndef MPK_PARALLEL_H
+#define MPK_PARALLEL_H
+
+#include "common.h"
+
+// Target size of the rows kept hot across the k levels of one step
+#define MPK_CACHE_BYTES (1 << 20)
+
+/**
+ * Wavefront schedule for one matrix and power count k.
+ * 
+ * Level j is swept in row order, lagging behind level j-1: a row r
+ * of level j is ready once level j-1 is complete for every column
+ * of rows 0..r (prefix maximum of the rows' largest column). Each
+ * step advances level 1 by one bucket and every other level as far
+ * as its dependencies allow, so the k levels touch a window of rows
+ * that is still in cache from the previous level.
+ * 
+ * For banded / stencil matrices the window is bucket + k·bandwidth.
+ * For matrices with long-range columns level 2 cannot start before
+ * level 1 ends, and the schedule falls back to k plain sweeps.
+ * 
+ * traffic_nnz counts a step's window once if it fits MPK_CACHE_BYTES,
+ * otherwise every level range of the step separately.
+ */
+typedef struct {
+    int k;                // Number of powers
+    int rows;
+    int bucket_rows;      // Rows added to level 1 per step
+    int num_steps;
+    int *level_end;       // Size: num_steps × k, rows done per level after each step
+    long long traffic_nnz; // Modelled matrix entries read from memory
+} MPK_Plan;
+
+// Build the schedule (bucket_rows ≤ 0: sized from MPK_CACHE_BYTES).
+// NULL if A is not square: Aʲ·x is only defined for rows == cols.
+MPK_Plan* mpk_plan_create(const CSR_Matrix *A, int k, int bucket_rows);
+void mpk_plan_free(MPK_Plan *P);
+
+/**
+ * Matrix powers: V[(j-1)·rows + i] = (Aʲ·x)[i] for j = 1..k (A square)
+ * 
+ * One parallel region; each step runs its k level ranges as static
+ * loops (a barrier between levels carries the in-step dependency).
+ * Results equal k successive spmv_csr_parallel calls.
+ * 
+ * Measured on one thread against 4 × spmv_bucket_parallel, k = 4:
+ * 1.3-1.6× faster on 2D Laplacians of 1M+ rows, whose matrix no longer
+ * sits in the last-level cache, but only 0.9-1.1× at 124K rows (8 MB),
+ * where k plain sweeps already hit in cache. The saving printed from
+ * traffic_nnz is modelled, not measured.
+ */
+void spmv_mpk_parallel(const CSR_Matrix *A, const MPK_Plan *P, const double *x, double *V);
+
+#endif // MPK_PARALLEL_H
@@ -0,0 +1,607 @@
+/**
+ * Multilevel Graph Partitioner Implementation
+ */
+
+#include "partition.h"
+
+#define COARSEN_TO      64     // Stop coarsening below this many vertices
+#define COARSEN_RATIO   0.95   // ...or when a level shrinks by < 5%
+#define INIT_TRIALS     8      // Graph-growing seeds for initial bisection
+#define FM_PASSES       8      // Max refinement passes per level
+#define FM_STALL        64     // Moves without improvement before a pass stops
+
+// ============================================
+// Graph (symmetric, weighted adjacency)
+// ============================================
+typedef struct {
+    int n;
+    int *xadj;        // Size: n+1
+    int *adjncy;      // Size: xadj[n]
+    int *adjwgt;      // Size: xadj[n]
+    int *vwgt;        // Size: n
+    int total_vwgt;
+} Graph;
+
+static Graph* graph_alloc(int n, int m) {
+    Graph *G = (Graph*)malloc(sizeof(Graph));
+    G->n = n;
+    G->xadj = (int*)calloc(n + 1, sizeof(int));
+    G->adjncy = (int*)malloc((m + 1) * sizeof(int));
+    G->adjwgt = (int*)malloc((m + 1) * sizeof(int));
+    G->vwgt = (int*)malloc((n + 1) * sizeof(int));
+    G->total_vwgt = 0;
+    return G;
+}
+
+static void graph_free(Graph *G) {
+    if (G) {
+        free(G->xadj);
+        free(G->adjncy);
+        free(G->adjwgt);
+        free(G->vwgt);
+        free(G);
+    }
+}
+
+// Pattern of A + Aᵀ without the diagonal; edge weight = 1 or 2
+static Graph* graph_from_csr(const CSR_Matrix *A) {
+    int n = A->rows;
+    
+    // Transpose pattern
+    int *t_ptr = (int*)calloc(n + 1, sizeof(int));
+    int *t_idx = (int*)malloc((A->nnz + 1) * sizeof(int));
+    for (int k = 0; k < A->nnz; k++) {
+        if (A->col_idx[k] < n) t_ptr[A->col_idx[k] + 1]++;
+    }
+    for (int i = 0; i < n; i++) t_ptr[i + 1] += t_ptr[i];
+    int *fill = (int*)malloc((n + 1) * sizeof(int));
+    memcpy(fill, t_ptr, (n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            int j = A->col_idx[k];
+            if (j < n) t_idx[fill[j]++] = i;
+        }
+    }
+    free(fill);
+    
+    Graph *G = graph_alloc(n, 2 * A->nnz);
+    int *marker = (int*)malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) marker[i] = -1;
+    
+    int pos = 0;
+    for (int i = 0; i < n; i++) {
+        int start = pos;
+        for (int pass = 0; pass < 2; pass++) {
+            const int *idx = (pass == 0) ? A->col_idx : t_idx;
+            int k0 = (pass == 0) ? A->row_ptr[i] : t_ptr[i];
+            int k1 = (pass == 0) ? A->row_ptr[i + 1] : t_ptr[i + 1];
+            for (int k = k0; k < k1; k++) {
+                int j = idx[k];
+                if (j == i || j >= n) continue;
+                if (marker[j] >= start) {
+                    G->adjwgt[marker[j]]++;
+                } else {
+                    marker[j] = pos;
+                    G->adjncy[pos] = j;
+                    G->adjwgt[pos] = 1;
+                    pos++;
+                }
+            }
+        }
+        G->xadj[i + 1] = pos;
+        
+        int len = A->row_ptr[i + 1] - A->row_ptr[i];
+        G->vwgt[i] = (len > 0) ? len : 1;
+        G->total_vwgt += G->vwgt[i];
+    }
+    
+    free(marker);
+    free(t_ptr);
+    free(t_idx);
+    return G;
+}
+
+// Induced subgraph on vertices with where[v] == side
+static Graph* graph_extract(const Graph *G, const int *where, int side,
+                            const int *vmap, int **sub_vmap) {
+    int *local = (int*)malloc((G->n + 1) * sizeof(int));
+    int sn = 0, sm = 0;
+    for (int v = 0; v < G->n; v++) {
+        if (where[v] == side) {
+            local[v] = sn++;
+            sm += G->xadj[v + 1] - G->xadj[v];
+        } else {
+            local[v] = -1;
+        }
+    }
+    
+    Graph *S = graph_alloc(sn, sm);
+    *sub_vmap = (int*)malloc((sn + 1) * sizeof(int));
+    
+    int pos = 0;
+    for (int v = 0; v < G->n; v++) {
+        if (local[v] < 0) continue;
+        int lv = local[v];
+        for (int e = G->xadj[v]; e < G->xadj[v + 1]; e++) {
+            int u = G->adjncy[e];
+            if (local[u] >= 0) {
+                S->adjncy[pos] = local[u];
+                S->adjwgt[pos] = G->adjwgt[e];
+                pos++;
+            }
+        }
+        S->xadj[lv + 1] = pos;
+        S->vwgt[lv] = G->vwgt[v];
+        S->total_vwgt += G->vwgt[v];
+        (*sub_vmap)[lv] = vmap[v];
+    }
+    
+    free(local);
+    return S;
+}
+
+// ============================================
+// Coarsening (heavy-edge matching)
+// ============================================
+
+// Returns coarse graph; cmap[v] = coarse vertex of v
+static Graph* coarsen(const Graph *G, int *cmap, unsigned int *seed) {
+    int n = G->n;
+    int *match = (int*)malloc((n + 1) * sizeof(int));
+    int *order = (int*)malloc((n + 1) * sizeof(int));
+    
+    for (int v = 0; v < n; v++) {
+        match[v] = -1;
+        order[v] = v;
+    }
+    for (int v = n - 1; v > 0; v--) {
+        int r = (int)(rand_r(seed) % (unsigned int)(v + 1));
+        int tmp = order[v]; order[v] = order[r]; order[r] = tmp;
+    }
+    
+    // Keep coarse vertices from growing too heavy to balance
+    int max_vwgt = (int)(1.5 * G->total_vwgt / COARSEN_TO) + 1;
+    
+    for (int o = 0; o < n; o++) {
+        int v = order[o];
+        if (match[v] != -1) continue;
+        
+        int best = -1, best_w = -1;
+        for (int e = G->xadj[v]; e < G->xadj[v + 1]; e++) {
+            int u = G->adjncy[e];
+            if (match[u] == -1 && G->adjwgt[e] > best_w &&
+                G->vwgt[v] + G->vwgt[u] <= max_vwgt) {
+                best = u;
+                best_w = G->adjwgt[e];
+            }
+        }
+        if (best >= 0) {
+            match[v] = best;
+            match[best] = v;
+        } else {
+            match[v] = v;
+        }
+    }
+    
+    int cn = 0;
+    for (int v = 0; v < n; v++) {
+        if (v <= match[v]) {
+            cmap[v] = cn;
+            cmap[match[v]] = cn;
+            cn++;
+        }
+    }
+    
+    // Build coarse graph, merging parallel edges
+    Graph *C = graph_alloc(cn, G->xadj[n]);
+    int *marker = (int*)malloc((cn + 1) * sizeof(int));
+    for (int c = 0; c < cn; c++) marker[c] = -1;
+    
+    int pos = 0;
+    for (int v = 0; v < n; v++) {
+        if (v > match[v]) continue;
+        int c = cmap[v];
+        int start = pos;
+        int pair[2] = {v, match[v]};
+        int members = (match[v] == v) ? 1 : 2;
+        
+        C->vwgt[c] = 0;
+        for (int m = 0; m < members; m++) {
+            int x = pair[m];
+            C->vwgt[c] += G->vwgt[x];
+            for (int e = G->xadj[x]; e < G->xadj[x + 1]; e++) {
+                int cu = cmap[G->adjncy[e]];
+                if (cu == c) continue;
+                if (marker[cu] >= start) {
+                    C->adjwgt[marker[cu]] += G->adjwgt[e];
+                } else {
+                    marker[cu] = pos;
+                    C->adjncy[pos] = cu;
+                    C->adjwgt[pos] = G->adjwgt[e];
+                    pos++;
+                }
+            }
+        }
+        C->xadj[c + 1] = pos;
+    }
+    C->total_vwgt = G->total_vwgt;
+    
+    free(marker);
+    free(match);
+    free(order);
+    return C;
+}
+
+// ============================================
+// FM Refinement (2-way)
+// ============================================
+typedef struct {
+    int gain;
+    int v;
+} Heap_Entry;
+
+static void heap_push(Heap_Entry *h, int *size, int gain, int v) {
+    int i = (*size)++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (h[parent].gain >= gain) break;
+        h[i] = h[parent];
+        i = parent;
+    }
+    h[i].gain = gain;
+    h[i].v = v;
+}
+
+static Heap_Entry heap_pop(Heap_Entry *h, int *size) {
+    Heap_Entry top = h[0];
+    Heap_Entry last = h[--(*size)];
+    int i = 0;
+    while (2 * i + 1 < *size) {
+        int c = 2 * i + 1;
+        if (c + 1 < *size && h[c + 1].gain > h[c].gain) c++;
+        if (last.gain >= h[c].gain) break;
+        h[i] = h[c];
+        i = c;
+    }
+    h[i] = last;
+    return top;
+}
+
+static int compute_cut(const Graph *G, const int *where) {
+    int cut = 0;
+    for (int v = 0; v < G->n; v++) {
+        for (int e = G->xadj[v]; e < G->xadj[v + 1]; e++) {
+            if (where[G->adjncy[e]] != where[v]) cut += G->adjwgt[e];
+        }
+    }
+    return cut / 2;
+}
+
+// Distance of side-0 weight from the allowed window (0 = feasible)
+static int balance_violation(int w0, int lo0, int hi0) {
+    if (w0 < lo0) return lo0 - w0;
+    if (w0 > hi0) return w0 - hi0;
+    return 0;
+}
+
+static void fm_refine(const Graph *G, int *where, int target0, int slack) {
+    int n = G->n;
+    int lo0 = target0 - slack;
+    int hi0 = target0 + slack;
+    
+    int *gain = (int*)malloc((n + 1) * sizeof(int));
+    int *locked = (int*)malloc((n + 1) * sizeof(int));
+    int *moves = (int*)malloc((n + 1) * sizeof(int));
+    Heap_Entry *heap = (Heap_Entry*)malloc((n + G->xadj[n] + 1) * sizeof(Heap_Entry));
+    
+    int w0 = 0;
+    for (int v = 0; v < n; v++) {
+        if (where[v] == 0) w0 += G->vwgt[v];
+    }
+    int cut = compute_cut(G, where);
+    
+    for (int pass = 0; pass < FM_PASSES; pass++) {
+        int heap_size = 0;
+        for (int v = 0; v < n; v++) {
+            int ext = 0, in = 0;
+            for (int e = G->xadj[v]; e < G->xadj[v + 1]; e++) {
+                if (where[G->adjncy[e]] != where[v]) ext += G->adjwgt[e];
+                else in += G->adjwgt[e];
+            }
+            gain[v] = ext - in;
+            locked[v] = 0;
+            // Boundary vertices, plus everything while unbalanced
+            if (ext > 0 || balance_violation(w0, lo0, hi0) > 0) {
+                heap_push(heap, &heap_size, gain[v], v);
+            }
+        }
+        
+        int start_cut = cut;
+        int start_viol = balance_violation(w0, lo0, hi0);
+        int best_cut = cut, best_viol = start_viol, best_moves = 0;
+        int num_moves = 0, stall = 0;
+        
+        while (heap_size > 0 && stall < FM_STALL) {
+            Heap_Entry top = heap_pop(heap, &heap_size);
+            int v = top.v;
+            if (locked[v] || top.gain != gain[v]) continue;   // stale
+            
+            int dw = (where[v] == 0) ? -G->vwgt[v] : G->vwgt[v];
+            int viol_now = balance_violation(w0, lo0, hi0);
+            int viol_new = balance_violation(w0 + dw, lo0, hi0);
+            if (viol_new > 0 && viol_new >= viol_now) continue;
+            
+            // Move v
+            where[v] = 1 - where[v];
+            w0 += dw;
+            cut -= gain[v];
+            locked[v] = 1;
+            moves[num_moves++] = v;
+            
+            for (int e = G->xadj[v]; e < G->xadj[v + 1]; e++) {
+                int u = G->adjncy[e];
+                if (locked[u]) continue;
+                gain[u] += (where[u] == where[v]) ? -2 * G->adjwgt[e] : 2 * G->adjwgt[e];
+                heap_push(heap, &heap_size, gain[u], u);
+            }
+            
+            if (viol_new < best_viol || (viol_new == best_viol && cut < best_cut)) {
+                best_cut = cut;
+                best_viol = viol_new;
+                best_moves = num_moves;
+                stall = 0;
+            } else {
+                stall++;
+            }
+        }
+        
+        // Roll back to the best prefix
+        for (int m = num_moves - 1; m >= best_moves; m--) {
+            int v = moves[m];
+            w0 += (where[v] == 0) ? -G->vwgt[v] : G->vwgt[v];
+            where[v] = 1 - where[v];
+        }
+        cut = best_cut;
+        
+        if (best_cut >= start_cut && best_viol >= start_viol) break;
+    }
+    
+    free(gain);
+    free(locked);
+    free(moves);
+    free(heap);
+}
+
+// ============================================
+// Initial Bisection (greedy graph growing)
+// ============================================
+static void initial_bisection(const Graph *G, int *where, int target0, int slack,
+                              unsigned int *seed) {
+    int n = G->n;
+    int *trial = (int*)malloc((n + 1) * sizeof(int));
+    int *queue = (int*)malloc((n + 1) * sizeof(int));
+    int best_cut = -1;
+    
+    for (int t = 0; t < INIT_TRIALS; t++) {
+        for (int v = 0; v < n; v++) trial[v] = 1;
+        
+        int w0 = 0, head = 0, tail = 0;
+        int next_seed = (int)(rand_r(seed) % (unsigned int)(n > 0 ? n : 1));
+        
+        // BFS from a random seed; restart on disconnected pieces
+        while (w0 < target0) {
+            if (head == tail) {
+                int tries = 0;
+                while (tries < n && trial[next_seed] == 0) {
+                    next_seed = (next_seed + 1) % n;
+                    tries++;
+                }
+                if (tries == n) break;
+                trial[next_seed] = 0;
+                w0 += G->vwgt[next_seed];
+                queue[tail++] = next_seed;
+                continue;
+            }
+            int v = queue[head++];
+            for (int e = G->xadj[v]; e < G->xadj[v + 1] && w0 < target0; e++) {
+                int u = G->adjncy[e];
+                if (trial[u] == 1) {
+                    trial[u] = 0;
+                    w0 += G->vwgt[u];
+                    queue[tail++] = u;
+                }
+            }
+        }
+        
+        fm_refine(G, trial, target0, slack);
+        int cut = compute_cut(G, trial);
+        if (best_cut < 0 || cut < best_cut) {
+            best_cut = cut;
+            memcpy(where, trial, n * sizeof(int));
+        }
+    }
+    
+    free(trial);
+    free(queue);
+}
+
+// ============================================
+// Multilevel Bisection
+// ============================================
+// ub: allowed relative deviation of each side from its target weight
+static int* multilevel_bisect(Graph *G, double frac0, double ub, unsigned int *seed) {
+    // Levels: graphs[0] = G, graphs[l+1] = coarsen(graphs[l])
+    int max_levels = 64;
+    Graph **graphs = (Graph**)malloc(max_levels * sizeof(Graph*));
+    int **cmaps = (int**)malloc(max_levels * sizeof(int*));
+    int levels = 1;
+    graphs[0] = G;
+    
+    while (levels < max_levels && graphs[levels - 1]->n > COARSEN_TO) {
+        Graph *F = graphs[levels - 1];
+        int *cmap = (int*)malloc((F->n + 1) * sizeof(int));
+        Graph *C = coarsen(F, cmap, seed);
+        if (C->n > COARSEN_RATIO * F->n) {
+            graph_free(C);
+            free(cmap);
+            break;
+        }
+        cmaps[levels - 1] = cmap;
+        graphs[levels++] = C;
+    }
+    
+    int target0 = (int)(G->total_vwgt * frac0 + 0.5);
+    int max_vwgt = 0;
+    for (int v = 0; v < G->n; v++) {
+        if (G->vwgt[v] > max_vwgt) max_vwgt = G->vwgt[v];
+    }
+    int smaller = (target0 < G->total_vwgt - target0) ? target0 : G->total_vwgt - target0;
+    int slack = (int)(ub * smaller);
+    if (slack < max_vwgt) slack = max_vwgt;
+    
+    // Coarsest level
+    Graph *C = graphs[levels - 1];
+    int *where = (int*)malloc((C->n + 1) * sizeof(int));
+    int coarse_slack = slack;
+    for (int v = 0; v < C->n; v++) {
+        if (C->vwgt[v] > coarse_slack) coarse_slack = C->vwgt[v];
+    }
+    initial_bisection(C, where, target0, coarse_slack, seed);
+    
+    // Uncoarsen: project + refine
+    for (int l = levels - 2; l >= 0; l--) {
+        Graph *F = graphs[l];
+        int *fine = (int*)malloc((F->n + 1) * sizeof(int));
+        for (int v = 0; v < F->n; v++) {
+            fine[v] = where[cmaps[l][v]];
+        }
+        free(where);
+        where = fine;
+        fm_refine(F, where, target0, slack);
+        
+        graph_free(graphs[l + 1]);
+        free(cmaps[l]);
+    }
+    
+    free(graphs);
+    free(cmaps);
+    return where;
+}
+
+static void partition_recursive(Graph *G, const int *vmap, int nparts, int offset,
+                                double ub, int *part, unsigned int *seed) {
+    if (nparts == 1 || G->n == 0) {
+        for (int v = 0; v < G->n; v++) part[vmap[v]] = offset;
+        return;
+    }
+    
+    int k0 = nparts / 2;
+    int *where = multilevel_bisect(G, (double)k0 / nparts, ub, seed);
+    
+    for (int side = 0; side < 2; side++) {
+        int *sub_vmap;
+        Graph *S = graph_extract(G, where, side, vmap, &sub_vmap);
+        if (side == 0) partition_recursive(S, sub_vmap, k0, offset, ub, part, seed);
+        else partition_recursive(S, sub_vmap, nparts - k0, offset + k0, ub, part, seed);
+        graph_free(S);
+        free(sub_vmap);
+    }
+    
+    free(where);
+}
+
+// ============================================
+// Public API
+// ============================================
+
+int* graph_partition(const CSR_Matrix *A, int nparts, unsigned int seed) {
+    int *part = (int*)malloc((A->rows + 1) * sizeof(int));
+    Graph *G = graph_from_csr(A);
+    
+    int *vmap = (int*)malloc((A->rows + 1) * sizeof(int));
+    for (int v = 0; v < A->rows; v++) vmap[v] = v;
+    
+    // Imbalance compounds over the log2(nparts) bisection levels
+    int depth = 0;
+    while ((1 << depth) < nparts) depth++;
+    double ub = PARTITION_UBFACTOR / (depth > 0 ? depth : 1);
+    
+    partition_recursive(G, vmap, nparts, 0, ub, part, &seed);
+    
+    free(vmap);
+    graph_free(G);
+    return part;
+}
+
+void partition_contiguous(int rows, int nparts, int *part) {
+    int base = rows / nparts;
+    int extra = rows % nparts;
+    int row = 0;
+    for (int p = 0; p < nparts; p++) {
+        int count = base + (p < extra ? 1 : 0);
+        for (int i = 0; i < count; i++) part[row++] = p;
+    }
+}
+
+int* partition_order(const int *part, int rows, int nparts, int *part_starts) {
+    int *perm = (int*)malloc((rows + 1) * sizeof(int));
+    
+    for (int p = 0; p <= nparts; p++) part_starts[p] = 0;
+    for (int i = 0; i < rows; i++) part_starts[part[i] + 1]++;
+    for (int p = 0; p < nparts; p++) part_starts[p + 1] += part_starts[p];
+    
+    int *fill = (int*)malloc((nparts + 1) * sizeof(int));
+    memcpy(fill, part_starts, (nparts + 1) * sizeof(int));
+    for (int i = 0; i < rows; i++) {
+        perm[fill[part[i]]++] = i;
+    }
+    
+    free(fill);
+    return perm;
+}
+
+void partition_stats(const CSR_Matrix *A, const int *part, int nparts,
+                     Partition_Stats *st) {
+    int *part_starts = (int*)malloc((nparts + 1) * sizeof(int));
+    int *order = partition_order(part, A->rows, nparts, part_starts);
+    int *marker = (int*)malloc((A->cols + 1) * sizeof(int));
+    long long *part_nnz = (long long*)calloc(nparts, sizeof(long long));
+    
+    for (int j = 0; j < A->cols; j++) marker[j] = -1;
+    
+    st->nparts = nparts;
+    st->edge_cut = 0;
+    st->halo_volume = 0;
+    st->max_halo = 0;
+    
+    for (int p = 0; p < nparts; p++) {
+        int halo = 0;
+        for (int r = part_starts[p]; r < part_starts[p + 1]; r++) {
+            int i = order[r];
+            part_nnz[p] += A->row_ptr[i + 1] - A->row_ptr[i];
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                int j = A->col_idx[k];
+                int owner = (j < A->rows) ? part[j] : p;
+                if (owner == p) continue;
+                st->edge_cut++;
+                if (marker[j] != p) {
+                    marker[j] = p;
+                    halo++;
+                }
+            }
+        }
+        st->halo_volume += halo;
+        if (halo > st->max_halo) st->max_halo = halo;
+    }
+    
+    long long max_nnz = 0;
+    for (int p = 0; p < nparts; p++) {
+        if (part_nnz[p] > max_nnz) max_nnz = part_nnz[p];
+    }
+    st->imbalance = (A->nnz > 0) ? (double)max_nnz * nparts / A->nnz : 1.0;
+    
+    free(part_starts);
+    free(order);
+    free(marker);
+    free(part_nnz);
+}
@@ -0,0 +1,57 @@
+/**
+ * Multilevel Graph Partitioner
+ * Row-to-part maps for distributed SpMV (no METIS dependency)
+ */
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "common.h"
+
+// Quality of a row-to-part map
+typedef struct {
+    int nparts;
+    int edge_cut;         // Nonzeros A[i][j] with part[i] != part[j]
+    int halo_volume;      // Σ over parts of distinct off-part columns
+                          // (= doubles received per distributed SpMV)
+    int max_halo;         // Largest per-part halo
+    double imbalance;     // max part nnz / average part nnz
+} Partition_Stats;
+
+/**
+ * Multilevel k-way partition by recursive bisection
+ * 
+ * Each bisection:
+ * 1. Coarsening: heavy-edge matching on the symmetrized pattern
+ *    of A until the graph is small (or stops shrinking)
+ * 2. Initial bisection: greedy graph growing from several seeds
+ * 3. Uncoarsening: project and refine with Fiduccia-Mattheyses
+ * 
+ * Vertex weight = row nnz, so parts are balanced for SpMV work
+ * (within PARTITION_UBFACTOR). Deterministic for a given seed.
+ * 
+ * Returns part[rows] with values in [0, nparts)
+ */
+#define PARTITION_UBFACTOR 0.03
+
+int* graph_partition(const CSR_Matrix *A, int nparts, unsigned int seed);
+
+/**
+ * Naive contiguous row blocks (same split as dist_row_partition)
+ */
+void partition_contiguous(int rows, int nparts, int *part);
+
+/**
+ * Edge cut, halo volume and load imbalance of a partition
+ */
+void partition_stats(const CSR_Matrix *A, const int *part, int nparts,
+                     Partition_Stats *st);
+
+/**
+ * Row order that makes every part contiguous (stable within a part).
+ * Returns perm[new] = old; part_starts: nparts+1 offsets.
+ * Use with csr_permute to feed dist_csr_create.
+ */
+int* partition_order(const int *part, int rows, int nparts, int *part_starts);
+
+#endif // PARTITION_H
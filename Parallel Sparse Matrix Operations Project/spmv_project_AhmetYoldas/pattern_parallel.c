@@ -0,0 +1,91 @@
+/**
+ * Pattern-Only SpMV Implementation
+ */
+
+#include "pattern_parallel.h"
+#include <omp.h>
+
+void spmv_csr_pattern_parallel(const CSR_Pattern_Matrix *A, const double *x, double *y) {
+    const double value = A->value;
+    
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < A->rows; i++) {
+        double sum = 0.0;
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            sum += x[A->col_idx[k]];
+        }
+        y[i] = value * sum;
+    }
+}
+
+void spmv_bucket_pattern_parallel(const CSR_Pattern_Matrix *A, const double *x, double *y) {
+    const double value = A->value;
+    
+    // Same adaptive bucket size as Method 4
+    int min_buckets = omp_get_max_threads() * 4;
+    int bucket_size = A->rows / min_buckets;
+    if (bucket_size < 32) bucket_size = 32;
+    if (bucket_size > 512) bucket_size = 512;
+    
+    int num_buckets = (A->rows + bucket_size - 1) / bucket_size;
+    
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int bucket_id = 0; bucket_id < num_buckets; bucket_id++) {
+        int bucket_start = bucket_id * bucket_size;
+        int bucket_end = (bucket_start + bucket_size < A->rows) ?
+                         bucket_start + bucket_size : A->rows;
+        
+        for (int i = bucket_start; i < bucket_end; i++) {
+            double sum = 0.0;
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                sum += x[A->col_idx[k]];
+            }
+            y[i] = value * sum;
+        }
+    }
+}
+
+// Row nibble of a block mask → 0/1 selectors for the 4 columns.
+// Multiplying by a selector keeps the inner block branch-free.
+static const double MASK_SEL[16][4] = {
+    {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0},
+    {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+    {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1},
+    {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1}
+};
+
+void spmv_bcsr_pattern_parallel(const BCSR_Pattern_Matrix *A, const double *x, double *y) {
+    const double value = A->value;
+    
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int br = 0; br < A->block_rows; br++) {
+        int row_start = br * 4;
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        
+        for (int kb = A->block_row_ptr[br]; kb < A->block_row_ptr[br + 1]; kb++) {
+            int col_start = A->block_col_idx[kb] * 4;
+            unsigned m = A->block_mask[kb];
+            
+            // Padding columns are never set in the mask
+            double x0 = (col_start + 0 < A->cols) ? x[col_start + 0] : 0.0;
+            double x1 = (col_start + 1 < A->cols) ? x[col_start + 1] : 0.0;
+            double x2 = (col_start + 2 < A->cols) ? x[col_start + 2] : 0.0;
+            double x3 = (col_start + 3 < A->cols) ? x[col_start + 3] : 0.0;
+            
+            const double *r0 = MASK_SEL[m & 0xF];
+            const double *r1 = MASK_SEL[(m >> 4) & 0xF];
+            const double *r2 = MASK_SEL[(m >> 8) & 0xF];
+            const double *r3 = MASK_SEL[(m >> 12) & 0xF];
+            
+            s0 += r0[0] * x0 + r0[1] * x1 + r0[2] * x2 + r0[3] * x3;
+            s1 += r1[0] * x0 + r1[1] * x1 + r1[2] * x2 + r1[3] * x3;
+            s2 += r2[0] * x0 + r2[1] * x1 + r2[2] * x2 + r2[3] * x3;
+            s3 += r3[0] * x0 + r3[1] * x1 + r3[2] * x2 + r3[3] * x3;
+        }
+        
+        if (row_start + 0 < A->rows) y[row_start + 0] = value * s0;
+        if (row_start + 1 < A->rows) y[row_start + 1] = value * s1;
+        if (row_start + 2 < A->rows) y[row_start + 2] = value * s2;
+        if (row_start + 3 < A->rows) y[row_start + 3] = value * s3;
+    }
+}
@@ -0,0 +1,32 @@
+/**
+ * Pattern-Only SpMV
+ * Values-free kernels for matrices with uniform values
+ */
+
+#ifndef PATTERN_PARALLEL_H
+#define PATTERN_PARALLEL_H
+
+#include "common.h"
+
+/**
+ * Pattern-only SpMV: y = value · (Σ x[col] over each row)
+ * 
+ * Adjacency / incidence matrices store the same value for every entry,
+ * so the value array (8 bytes per nonzero) is pure overhead. Dropping
+ * it cuts CSR traffic from 12 to 4 bytes per nonzero and turns the
+ * inner loop into a gather-sum; the scale is applied once per row.
+ * 
+ *   spmv_csr_pattern_parallel    - Method 2 structure (dynamic, 64)
+ *   spmv_bucket_pattern_parallel - Method 4 structure (adaptive buckets)
+ *   spmv_bcsr_pattern_parallel   - Method 3 structure, 4×4 blocks held
+ *                                  as a 16-bit mask (2 bytes per block
+ *                                  instead of 128)
+ * 
+ * Build the inputs with csr_to_pattern / csr_to_bcsr_pattern, which
+ * return NULL when the values are not uniform.
+ */
+void spmv_csr_pattern_parallel(const CSR_Pattern_Matrix *A, const double *x, double *y);
+void spmv_bucket_pattern_parallel(const CSR_Pattern_Matrix *A, const double *x, double *y);
+void spmv_bcsr_pattern_parallel(const BCSR_Pattern_Matrix *A, const double *x, double *y);
+
+#endif // PATTERN_PARALLEL_H
@@ -64,7 +64,23 @@ echo "  ✓ csr_parallel.c/h        - Method 2 (OpenMP)"
 echo "  ✓ bcsr_parallel.c/h       - Method 3 (4×4 + OpenMP)"
 echo "  ✓ bucket_parallel.c/h     - Method 4 (Buckets + OpenMP)"
 echo "  ✓ bcsr_bucket_parallel.c/h - Method 5 (Hybrid) ⭐"
+echo "  ✓ csr64_parallel.c/h      - 32/64-bit row_ptr kernels"
+echo "  ✓ csrdu_parallel.c/h      - Delta-encoded columns (CSR-DU)"
+echo "  ✓ mixed_precision.c/h     - float/bf16/fp16 values"
+echo "  ✓ stream_parallel.c/h     - Out-of-core streaming"
+echo "  ✓ partition.c/h           - Multilevel graph partitioner"
+echo "  ✓ semiring.c/h            - Semiring-generic SpMV"
+echo "  ✓ spmspv.c/h              - Sparse-vector SpMSpV (push/pull)"
+echo "  ✓ pattern_parallel.c/h    - Values-free (pattern-only) kernels"
+echo "  ✓ dict_parallel.c/h       - Dictionary-compressed values"
+echo "  ✓ binned_parallel.c/h     - Row-length-binned scheduler"
+echo "  ✓ csr5_parallel.c/h       - CSR5 tiles (segmented sum)"
+echo "  ✓ merge_parallel.c/h      - Merge-path balanced CSR"
+echo "  ✓ csb_parallel.c/h        - Compressed Sparse Blocks (Ax, Aᵀx)"
+echo "  ✓ mpk_parallel.c/h        - Matrix-powers kernel (Aᵏx)"
+echo "  ✓ dist_spmv.c/h           - MPI distributed SpMV (make mpi)"
 echo "  ✓ benchmark.c             - Main program"
+echo "  ✓ stream_bench.c          - Out-of-core benchmark (make stream_run)"
 echo ""
 
 # Build
@@ -0,0 +1,52 @@
+/**
+ * Semiring-Generic SpMV Implementation
+ */
+
+#include "semiring.h"
+#include <omp.h>
+
+#define DEFINE_SEMIRING_SPMV(NAME, ZERO, ADD, MUL)                          \
+void spmv_csr_serial_##NAME(const CSR_Matrix *A, const double *x, double *y) { \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = ZERO;                                                  \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum = ADD(sum, MUL(A->values[k], x[A->col_idx[k]]));            \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+void spmv_csr_parallel_##NAME(const CSR_Matrix *A, const double *x, double *y) { \
+    _Pragma("omp parallel for schedule(dynamic, 64)")                      \
+    for (int i = 0; i < A->rows; i++) {                                     \
+        double sum = ZERO;                                                  \
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {             \
+            sum = ADD(sum, MUL(A->values[k], x[A->col_idx[k]]));            \
+        }                                                                   \
+        y[i] = sum;                                                         \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+void spmv_bucket_parallel_##NAME(const CSR_Matrix *A, const double *x, double *y) { \
+    int min_buckets = omp_get_max_threads() * 4;                            \
+    int bucket_size = A->rows / min_buckets;                                \
+    if (bucket_size < 32) bucket_size = 32;                                 \
+    if (bucket_size > 512) bucket_size = 512;                               \
+    int num_buckets = (A->rows + bucket_size - 1) / bucket_size;            \
+                                                                            \
+    _Pragma("omp parallel for schedule(dynamic, 1)")                       \
+    for (int bucket_id = 0; bucket_id < num_buckets; bucket_id++) {         \
+        int bucket_start = bucket_id * bucket_size;                         \
+        int bucket_end = (bucket_start + bucket_size < A->rows) ?           \
+                         bucket_start + bucket_size : A->rows;              \
+        for (int i = bucket_start; i < bucket_end; i++) {                   \
+            double sum = ZERO;                                              \
+            for (int k = A->row_ptr[i]; k < A->row_ptr[i+1]; k++) {         \
+                sum = ADD(sum, MUL(A->values[k], x[A->col_idx[k]]));        \
+            }                                                               \
+            y[i] = sum;                                                     \
+        }                                                                   \
+    }                                                                       \
+}
+
+SEMIRING_LIST(DEFINE_SEMIRING_SPMV)
@@ -0,0 +1,53 @@
+/**
+ * Semiring-Generic SpMV
+ * y = A ⊗ x over (⊕, ⊗) for graph analytics
+ */
+
+#ifndef SEMIRING_H
+#define SEMIRING_H
+
+#include "common.h"
+#include <math.h>
+
+// ============================================
+// Semirings: X(name, zero, add, mul)
+// ============================================
+// zero is the identity of ⊕; empty rows produce zero.
+//
+//   plus_times : (+, ×)     standard SpMV
+//   min_plus   : (min, +)   SSSP relaxation (A = edge lengths)
+//   max_min    : (max, min) widest path (A = capacities)
+//   max_times  : (max, ×)   most reliable path (A = probabilities)
+//   or_and     : (∨, ∧)     BFS reachability (nonzero = true)
+#define SR_PLUS(a, b)   ((a) + (b))
+#define SR_TIMES(a, b)  ((a) * (b))
+#define SR_MIN(a, b)    ((a) < (b) ? (a) : (b))
+#define SR_MAX(a, b)    ((a) > (b) ? (a) : (b))
+#define SR_OR(a, b)     (((a) != 0.0 || (b) != 0.0) ? 1.0 : 0.0)
+#define SR_AND(a, b)    (((a) != 0.0 && (b) != 0.0) ? 1.0 : 0.0)
+
+#define SEMIRING_LIST(X)                          \
+    X(plus_times, 0.0,       SR_PLUS, SR_TIMES)   \
+    X(min_plus,   INFINITY,  SR_MIN,  SR_PLUS)    \
+    X(max_min,    -INFINITY, SR_MAX,  SR_MIN)     \
+    X(max_times,  -INFINITY, SR_MAX,  SR_TIMES)   \
+    X(or_and,     0.0,       SR_OR,   SR_AND)
+
+/**
+ * For every semiring NAME in SEMIRING_LIST:
+ * 
+ *   spmv_csr_serial_NAME    - reference loop (Method 1 structure)
+ *   spmv_csr_parallel_NAME  - Method 2 structure (dynamic, 64)
+ *   spmv_bucket_parallel_NAME - Method 4 structure (adaptive buckets)
+ * 
+ * Each kernel is a separate macro instantiation, so ⊕/⊗ are inlined
+ * and plus_times compiles to the same loop as the hand-written code.
+ */
+#define DECLARE_SEMIRING_SPMV(NAME, ZERO, ADD, MUL)                                 \
+    void spmv_csr_serial_##NAME(const CSR_Matrix *A, const double *x, double *y);   \
+    void spmv_csr_parallel_##NAME(const CSR_Matrix *A, const double *x, double *y); \
+    void spmv_bucket_parallel_##NAME(const CSR_Matrix *A, const double *x, double *y);
+
+SEMIRING_LIST(DECLARE_SEMIRING_SPMV)
+
+#endif // SEMIRING_H
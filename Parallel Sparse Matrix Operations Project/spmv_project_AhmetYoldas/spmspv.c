@@ -0,0 +1,249 @@
+/**
+ * SpMSpV Implementation
+ */
+
+#include "spmspv.h"
+#include "csr_parallel.h"
+#include <omp.h>
+
+// ============================================
+// Memory Management
+// ============================================
+
+Sparse_Vector* sparse_vector_alloc(int n, int capacity) {
+    Sparse_Vector *v = (Sparse_Vector*)malloc(sizeof(Sparse_Vector));
+    v->n = n;
+    v->nnz = 0;
+    v->capacity = capacity;
+    v->idx = (int*)malloc((capacity + 1) * sizeof(int));
+    v->val = (double*)malloc((capacity + 1) * sizeof(double));
+    return v;
+}
+
+void sparse_vector_free(Sparse_Vector *v) {
+    if (v) {
+        free(v->idx);
+        free(v->val);
+        free(v);
+    }
+}
+
+SpMSpV_Workspace* spmspv_workspace_alloc(int rows, int cols) {
+    SpMSpV_Workspace *ws = (SpMSpV_Workspace*)malloc(sizeof(SpMSpV_Workspace));
+    
+    ws->rows = rows;
+    ws->cols = cols;
+    ws->num_threads = omp_get_max_threads();
+    
+    // Same adaptive rule as Method 4: >= 4 buckets per thread, 32..512 rows
+    int bucket_rows = rows / (ws->num_threads * 4);
+    if (bucket_rows < 32) bucket_rows = 32;
+    if (bucket_rows > 512) bucket_rows = 512;
+    ws->bucket_rows = bucket_rows;
+    ws->num_buckets = (rows + bucket_rows - 1) / bucket_rows;
+    
+    int slots = ws->num_threads * ws->num_buckets;
+    ws->counts = (int*)malloc((slots + 1) * sizeof(int));
+    ws->offsets = (int*)malloc((slots + 1) * sizeof(int));
+    ws->bucket_nnz = (int*)malloc((ws->num_buckets + 1) * sizeof(int));
+    
+    ws->capacity = 0;
+    ws->cont_idx = NULL;
+    ws->cont_val = NULL;
+    
+    ws->spa = (double*)calloc(rows + 1, sizeof(double));
+    ws->mark = (char*)calloc(rows + 1, sizeof(char));
+    ws->x_dense = (double*)calloc(cols + 1, sizeof(double));
+    ws->y_dense = (double*)malloc((rows + 1) * sizeof(double));
+    return ws;
+}
+
+void spmspv_workspace_free(SpMSpV_Workspace *ws) {
+    if (ws) {
+        free(ws->counts);
+        free(ws->offsets);
+        free(ws->bucket_nnz);
+        free(ws->cont_idx);
+        free(ws->cont_val);
+        free(ws->spa);
+        free(ws->mark);
+        free(ws->x_dense);
+        free(ws->y_dense);
+        free(ws);
+    }
+}
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// ============================================
+// Push: CSC SpMSpV
+// ============================================
+
+void spmspv_csc_parallel(const CSC_Matrix *A, const Sparse_Vector *x,
+                         Sparse_Vector *y, SpMSpV_Workspace *ws) {
+    int T = ws->num_threads;
+    int NB = ws->num_buckets;
+    int BR = ws->bucket_rows;
+    
+    // Total contributions = Σ column lengths of the frontier
+    long long work = 0;
+    for (int e = 0; e < x->nnz; e++) {
+        int j = x->idx[e];
+        work += A->col_ptr[j + 1] - A->col_ptr[j];
+    }
+    if (work > ws->capacity) {
+        free(ws->cont_idx);
+        free(ws->cont_val);
+        ws->capacity = (int)work;
+        ws->cont_idx = (int*)malloc((work + 1) * sizeof(int));
+        ws->cont_val = (double*)malloc((work + 1) * sizeof(double));
+    }
+    
+    #pragma omp parallel num_threads(T)
+    {
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        int *my_counts = ws->counts + t * NB;
+        
+        // Static share of x's nonzeros
+        int e_start = (int)((long long)x->nnz * t / nt);
+        int e_end = (int)((long long)x->nnz * (t + 1) / nt);
+        
+        // 1a. Count contributions per row bucket
+        for (int b = 0; b < NB; b++) my_counts[b] = 0;
+        for (int e = e_start; e < e_end; e++) {
+            int j = x->idx[e];
+            for (int k = A->col_ptr[j]; k < A->col_ptr[j + 1]; k++) {
+                my_counts[A->row_idx[k] / BR]++;
+            }
+        }
+        #pragma omp barrier
+        
+        // 1b. Bucket-major offsets: bucket b of all threads is contiguous
+        #pragma omp single
+        {
+            int pos = 0;
+            for (int b = 0; b < NB; b++) {
+                ws->bucket_nnz[b] = pos;
+                for (int tt = 0; tt < nt; tt++) {
+                    ws->offsets[tt * NB + b] = pos;
+                    pos += ws->counts[tt * NB + b];
+                }
+            }
+            ws->bucket_nnz[NB] = pos;
+        }
+        
+        // 1c. Scatter scaled columns into per-thread buckets
+        int *my_pos = ws->offsets + t * NB;
+        for (int e = e_start; e < e_end; e++) {
+            int j = x->idx[e];
+            double xj = x->val[e];
+            for (int k = A->col_ptr[j]; k < A->col_ptr[j + 1]; k++) {
+                int i = A->row_idx[k];
+                int p = my_pos[i / BR]++;
+                ws->cont_idx[p] = i;
+                ws->cont_val[p] = A->values[k] * xj;
+            }
+        }
+        #pragma omp barrier
+        
+        // 2. Merge each bucket; results overwrite the start of its segment
+        #pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < NB; b++) {
+            int seg_start = ws->bucket_nnz[b];
+            int seg_end = ws->bucket_nnz[b + 1];
+            int unique = 0;
+            
+            for (int p = seg_start; p < seg_end; p++) {
+                int i = ws->cont_idx[p];
+                if (!ws->mark[i]) {
+                    ws->mark[i] = 1;
+                    ws->cont_idx[seg_start + unique++] = i;   // unique <= p
+                }
+                ws->spa[i] += ws->cont_val[p];
+            }
+            
+            int *rows = ws->cont_idx + seg_start;
+            qsort(rows, unique, sizeof(int), compare_int);
+            
+            int kept = 0;
+            for (int u = 0; u < unique; u++) {
+                int i = rows[u];
+                double v = ws->spa[i];
+                ws->spa[i] = 0.0;
+                ws->mark[i] = 0;
+                if (v != 0.0) {
+                    rows[kept] = i;
+                    ws->cont_val[seg_start + kept] = v;
+                    kept++;
+                }
+            }
+            ws->counts[b] = kept;    // counts[] reused as per-bucket output size
+        }
+        
+        // 3. Concatenate buckets into y
+        #pragma omp single
+        {
+            int pos = 0;
+            for (int b = 0; b < NB; b++) {
+                ws->offsets[b] = pos;
+                pos += ws->counts[b];
+            }
+            y->nnz = pos;
+        }
+        
+        #pragma omp for schedule(dynamic, 4)
+        for (int b = 0; b < NB; b++) {
+            memcpy(y->idx + ws->offsets[b], ws->cont_idx + ws->bucket_nnz[b],
+                   ws->counts[b] * sizeof(int));
+            memcpy(y->val + ws->offsets[b], ws->cont_val + ws->bucket_nnz[b],
+                   ws->counts[b] * sizeof(double));
+        }
+    }
+    
+    y->n = A->rows;
+}
+
+// ============================================
+// Direction-Optimizing Switch
+// ============================================
+
+int spmspv_direction_optimizing(const CSR_Matrix *A, const CSC_Matrix *A_csc,
+                                const Sparse_Vector *x, Sparse_Vector *y,
+                                SpMSpV_Workspace *ws) {
+    long long push_work = 0;
+    for (int e = 0; e < x->nnz; e++) {
+        int j = x->idx[e];
+        push_work += A_csc->col_ptr[j + 1] - A_csc->col_ptr[j];
+    }
+    
+    if (push_work <= SPMSPV_PULL_THRESHOLD * A->nnz) {
+        spmspv_csc_parallel(A_csc, x, y, ws);
+        return 0;
+    }
+    
+    // Pull: densify x, row-oriented SpMV, compact nonzeros
+    for (int e = 0; e < x->nnz; e++) {
+        ws->x_dense[x->idx[e]] = x->val[e];
+    }
+    spmv_csr_parallel(A, ws->x_dense, ws->y_dense);
+    for (int e = 0; e < x->nnz; e++) {
+        ws->x_dense[x->idx[e]] = 0.0;
+    }
+    
+    int nnz = 0;
+    for (int i = 0; i < A->rows; i++) {
+        if (ws->y_dense[i] != 0.0) {
+            y->idx[nnz] = i;
+            y->val[nnz] = ws->y_dense[i];
+            nnz++;
+        }
+    }
+    y->nnz = nnz;
+    y->n = A->rows;
+    return 1;
+}
@@ -0,0 +1,81 @@
+/**
+ * Sparse Matrix × Sparse Vector (SpMSpV)
+ * CSC push kernel + direction-optimizing switch to CSR pull
+ */
+
+#ifndef SPMSPV_H
+#define SPMSPV_H
+
+#include "common.h"
+
+// Switch to pull (dense CSR SpMV) when the push work, i.e. the number
+// of matrix entries in the frontier's columns, exceeds this fraction
+// of nnz(A). A pushed entry costs ~3-4× a pulled one (scatter + merge),
+// so the crossover sits at a few percent of nnz(A).
+#define SPMSPV_PULL_THRESHOLD 0.03
+
+// Sparse vector: (index, value) lists, indices ascending
+typedef struct {
+    int n;             // Logical length
+    int nnz;           // Stored entries
+    int capacity;
+    int *idx;          // Size: capacity
+    double *val;       // Size: capacity
+} Sparse_Vector;
+
+// Scratch space reused across calls (sized for one matrix)
+typedef struct {
+    int rows;
+    int cols;
+    int num_threads;
+    int num_buckets;      // Row buckets for the merge phase
+    int bucket_rows;
+    int *counts;          // num_threads × num_buckets contribution counts
+    int *offsets;         // num_threads × num_buckets (+1) start offsets
+    int *bucket_nnz;      // Size: num_buckets+1, merged entries per bucket
+    int capacity;         // Size of contribution arrays
+    int *cont_idx;
+    double *cont_val;
+    double *spa;          // Size: rows, dense accumulator (kept zero)
+    char *mark;           // Size: rows, touched flags (kept zero)
+    double *x_dense;      // Size: cols, for the pull path (kept zero)
+    double *y_dense;      // Size: rows, for the pull path
+} SpMSpV_Workspace;
+
+// Sparse vector memory management
+Sparse_Vector* sparse_vector_alloc(int n, int capacity);
+void sparse_vector_free(Sparse_Vector *v);
+
+// Workspace for A (rows × cols), threads = omp_get_max_threads()
+SpMSpV_Workspace* spmspv_workspace_alloc(int rows, int cols);
+void spmspv_workspace_free(SpMSpV_Workspace *ws);
+
+/**
+ * Push SpMSpV: y = A x with A in CSC, x sparse
+ * 
+ * 1. Each thread scales the columns of its share of x's nonzeros and
+ *    appends (row, a·x_j) to per-thread buckets (rows split in ranges)
+ * 2. Each row bucket is merged by one thread in a dense accumulator
+ *    that only touches that bucket's rows
+ * 3. Bucket results are concatenated into y (indices ascending)
+ * 
+ * Work is O(Σ column lengths of x's nonzeros), independent of rows.
+ * y must have capacity >= A->rows.
+ */
+void spmspv_csc_parallel(const CSC_Matrix *A, const Sparse_Vector *x,
+                         Sparse_Vector *y, SpMSpV_Workspace *ws);
+
+/**
+ * Direction-optimizing SpMSpV
+ * 
+ * - Sparse frontier: push (spmspv_csc_parallel)
+ * - Dense frontier:  pull (spmv_csr_parallel on a densified x)
+ * 
+ * Both paths return y as a sparse vector of the nonzero results.
+ * Returns 0 if push was used, 1 if pull was used.
+ */
+int spmspv_direction_optimizing(const CSR_Matrix *A, const CSC_Matrix *A_csc,
+                                const Sparse_Vector *x, Sparse_Vector *y,
+                                SpMSpV_Workspace *ws);
+
+#endif // SPMSPV_H
@@ -0,0 +1,231 @@
+/**
+ * Out-of-Core Streaming SpMV Implementation
+ */
+
+#include "stream_parallel.h"
+#include <omp.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+static double wall_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+// pread() until all bytes are in (returns 0 on success)
+static int read_full(int fd, void *buf, size_t bytes, int64_t offset) {
+    char *p = (char*)buf;
+    while (bytes > 0) {
+        ssize_t n = pread(fd, p, bytes, (off_t)offset);
+        if (n <= 0) return -1;
+        p += n;
+        bytes -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+// ============================================
+// Panels and pipeline state
+// ============================================
+typedef struct {
+    int row_start;
+    int row_end;
+} Panel;
+
+typedef struct {
+    int *col_idx;
+    double *values;
+    int full;           // 1 = loaded, waiting for compute
+} Panel_Buffer;
+
+typedef struct {
+    const CSR_File *F;
+    const Panel *panels;
+    int num_panels;
+    Panel_Buffer buf[STREAM_BUFFERS];
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    double io_time;
+    int error;
+} Pipeline;
+
+// Reader thread: fill buffers in panel order, STREAM_BUFFERS ahead
+static void* reader_main(void *arg) {
+    Pipeline *P = (Pipeline*)arg;
+    const CSR_File *F = P->F;
+    
+    for (int p = 0; p < P->num_panels; p++) {
+        Panel_Buffer *b = &P->buf[p % STREAM_BUFFERS];
+        
+        pthread_mutex_lock(&P->lock);
+        while (b->full) pthread_cond_wait(&P->cond, &P->lock);
+        pthread_mutex_unlock(&P->lock);
+        
+        int64_t k0 = F->row_ptr[P->panels[p].row_start];
+        int64_t k1 = F->row_ptr[P->panels[p].row_end];
+        size_t n = (size_t)(k1 - k0);
+        
+        double t = wall_time();
+        int err = read_full(F->fd, b->col_idx, n * sizeof(int),
+                            F->col_offset + k0 * (int64_t)sizeof(int)) ||
+                  read_full(F->fd, b->values, n * sizeof(double),
+                            F->val_offset + k0 * (int64_t)sizeof(double));
+        double dt = wall_time() - t;
+        
+        pthread_mutex_lock(&P->lock);
+        P->io_time += dt;
+        if (err) P->error = 1;
+        b->full = 1;
+        pthread_cond_broadcast(&P->cond);
+        pthread_mutex_unlock(&P->lock);
+        
+        if (err) break;
+    }
+    return NULL;
+}
+
+// One panel, processed in adaptive buckets like Method 4
+static void compute_panel(const CSR_File *F, const Panel *panel,
+                          const Panel_Buffer *b, const double *x, double *y) {
+    int rows = panel->row_end - panel->row_start;
+    int64_t base = F->row_ptr[panel->row_start];
+    
+    int min_buckets = omp_get_max_threads() * 4;
+    int bucket_size = rows / min_buckets;
+    if (bucket_size < 32) bucket_size = 32;
+    if (bucket_size > 512) bucket_size = 512;
+    int num_buckets = (rows + bucket_size - 1) / bucket_size;
+    
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int bucket_id = 0; bucket_id < num_buckets; bucket_id++) {
+        int bucket_start = panel->row_start + bucket_id * bucket_size;
+        int bucket_end = (bucket_start + bucket_size < panel->row_end) ?
+                         bucket_start + bucket_size : panel->row_end;
+        
+        for (int i = bucket_start; i < bucket_end; i++) {
+            double sum = 0.0;
+            for (int64_t k = F->row_ptr[i] - base; k < F->row_ptr[i+1] - base; k++) {
+                sum += b->values[k] * x[b->col_idx[k]];
+            }
+            y[i] = sum;
+        }
+    }
+}
+
+int spmv_csr_stream(const CSR_File *F, const double *x, double *y,
+                    int64_t panel_nnz, Stream_Stats *stats) {
+    double t_start = wall_time();
+    
+    // Cut rows into panels of ~panel_nnz nonzeros
+    Panel *panels = (Panel*)malloc(((size_t)F->rows + 1) * sizeof(Panel));
+    int num_panels = 0;
+    int64_t max_panel_nnz = 0;
+    int row = 0;
+    while (row < F->rows) {
+        int start = row;
+        while (row < F->rows &&
+               (row == start || F->row_ptr[row + 1] - F->row_ptr[start] <= panel_nnz)) {
+            row++;
+        }
+        panels[num_panels].row_start = start;
+        panels[num_panels].row_end = row;
+        if (F->row_ptr[row] - F->row_ptr[start] > max_panel_nnz) {
+            max_panel_nnz = F->row_ptr[row] - F->row_ptr[start];
+        }
+        num_panels++;
+    }
+    
+    Pipeline P;
+    P.F = F;
+    P.panels = panels;
+    P.num_panels = num_panels;
+    P.io_time = 0.0;
+    P.error = 0;
+    pthread_mutex_init(&P.lock, NULL);
+    pthread_cond_init(&P.cond, NULL);
+    for (int b = 0; b < STREAM_BUFFERS; b++) {
+        P.buf[b].col_idx = (int*)malloc((size_t)max_panel_nnz * sizeof(int) + 1);
+        P.buf[b].values = (double*)malloc((size_t)max_panel_nnz * sizeof(double) + 1);
+        P.buf[b].full = 0;
+    }
+    
+    posix_fadvise(F->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    pthread_t reader;
+    pthread_create(&reader, NULL, reader_main, &P);
+    
+    double io_wait = 0.0;
+    int error = 0;
+    
+    for (int p = 0; p < num_panels; p++) {
+        Panel_Buffer *b = &P.buf[p % STREAM_BUFFERS];
+        
+        double t = wall_time();
+        pthread_mutex_lock(&P.lock);
+        while (!b->full) pthread_cond_wait(&P.cond, &P.lock);
+        error = P.error;
+        pthread_mutex_unlock(&P.lock);
+        io_wait += wall_time() - t;
+        
+        if (error) break;
+        
+        compute_panel(F, &panels[p], b, x, y);
+        
+        pthread_mutex_lock(&P.lock);
+        b->full = 0;
+        pthread_cond_broadcast(&P.cond);
+        pthread_mutex_unlock(&P.lock);
+    }
+    
+    pthread_join(reader, NULL);
+    
+    if (stats) {
+        stats->num_panels = num_panels;
+        stats->bytes_read = F->nnz * (int64_t)(sizeof(int) + sizeof(double));
+        stats->total_time = wall_time() - t_start;
+        stats->io_time = P.io_time;
+        stats->io_wait_time = io_wait;
+    }
+    
+    for (int b = 0; b < STREAM_BUFFERS; b++) {
+        free(P.buf[b].col_idx);
+        free(P.buf[b].values);
+    }
+    pthread_mutex_destroy(&P.lock);
+    pthread_cond_destroy(&P.cond);
+    free(panels);
+    
+    if (error) {
+        printf("Error: Read failed while streaming matrix\n");
+        return -1;
+    }
+    return 0;
+}
+
+void csr_file_drop_cache(const CSR_File *F) {
+    posix_fadvise(F->fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+double csr_file_read_bandwidth(const CSR_File *F, int64_t chunk_bytes) {
+    int64_t total = F->nnz * (int64_t)(sizeof(int) + sizeof(double));
+    char *buf = (char*)malloc((size_t)chunk_bytes);
+    
+    posix_fadvise(F->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    double t = wall_time();
+    for (int64_t off = 0; off < total; off += chunk_bytes) {
+        int64_t n = (total - off < chunk_bytes) ? total - off : chunk_bytes;
+        if (read_full(F->fd, buf, (size_t)n, F->col_offset + off) != 0) {
+            free(buf);
+            return 0.0;
+        }
+    }
+    t = wall_time() - t;
+    
+    free(buf);
+    return total / t / 1e9;
+}
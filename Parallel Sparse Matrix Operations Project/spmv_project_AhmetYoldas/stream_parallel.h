@@ -0,0 +1,51 @@
+/**
+ * Out-of-Core Streaming SpMV
+ * Row panels read from a binary CSR file while computing
+ */
+
+#ifndef STREAM_PARALLEL_H
+#define STREAM_PARALLEL_H
+
+#include "common.h"
+
+// Number of panel buffers in the read-ahead pipeline (triple buffering)
+#define STREAM_BUFFERS 3
+
+// Statistics of one streaming SpMV
+typedef struct {
+    int num_panels;
+    int64_t bytes_read;     // col_idx + values bytes read from disk
+    double total_time;      // Wall time of the whole SpMV (sec)
+    double io_time;         // Time the reader thread spent in pread (sec)
+    double io_wait_time;    // Time compute waited for a panel (sec)
+} Stream_Stats;
+
+/**
+ * Streaming CSR SpMV over an on-disk matrix
+ * 
+ * Pipeline:
+ * - Rows are cut into panels of ~panel_nnz nonzeros (a row is never split)
+ * - A reader thread preads col_idx/values of panel p+1, p+2 into
+ *   STREAM_BUFFERS rotating buffers while panel p is computed
+ * - Each panel is computed like Method 4: adaptive row buckets,
+ *   OpenMP dynamic scheduling across buckets
+ * 
+ * Memory: row_ptr + x + y + STREAM_BUFFERS panels (not the matrix)
+ * 
+ * Returns 0 on success, -1 on read error. stats may be NULL.
+ */
+int spmv_csr_stream(const CSR_File *F, const double *x, double *y,
+                    int64_t panel_nnz, Stream_Stats *stats);
+
+/**
+ * Evict the matrix file from the page cache (cold-read benchmarks)
+ */
+void csr_file_drop_cache(const CSR_File *F);
+
+/**
+ * Raw sequential read bandwidth of the col_idx/values region (GB/s),
+ * read in chunk_bytes preads with no compute
+ */
+double csr_file_read_bandwidth(const CSR_File *F, int64_t chunk_bytes);
+
+#endif // STREAM_PARALLEL_H